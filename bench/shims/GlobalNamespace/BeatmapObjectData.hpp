@@ -0,0 +1,17 @@
+#pragma once
+
+#include "beatsaber-hook/shared/utils/typedefs.h"
+
+namespace GlobalNamespace {
+class BeatmapDataItem : public Il2CppObject {
+public:
+  using Il2CppObject::Il2CppObject;
+
+  float time = 0;
+};
+
+class BeatmapObjectData : public BeatmapDataItem {
+public:
+  using BeatmapDataItem::BeatmapDataItem;
+};
+} // namespace GlobalNamespace
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Component.hpp"
+
+namespace UnityEngine {
+class Behaviour : public Component {
+public:
+  using Component::Component;
+
+  bool enabled = true;
+};
+} // namespace UnityEngine
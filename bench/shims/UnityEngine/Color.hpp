@@ -0,0 +1,13 @@
+#pragma once
+
+namespace UnityEngine {
+struct Color {
+  float r = 0;
+  float g = 0;
+  float b = 0;
+  float a = 0;
+
+  constexpr Color() = default;
+  constexpr Color(float r, float g, float b, float a) : r(r), g(g), b(b), a(a) {}
+};
+} // namespace UnityEngine
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Object.hpp"
+
+namespace UnityEngine {
+class GameObject;
+class Transform;
+
+class Component : public Object {
+public:
+  using Object::Object;
+
+  GameObject* gameObject = nullptr;
+
+  GameObject* get_gameObject() const {
+    return gameObject;
+  }
+
+  Transform* get_transform() const;
+};
+} // namespace UnityEngine
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Object.hpp"
+#include "Transform.hpp"
+
+namespace UnityEngine {
+class GameObject : public Object {
+public:
+  GameObject() : transform(std::make_unique<Transform>()) {
+    transform->gameObject = this;
+  }
+  explicit GameObject(std::string_view name) : GameObject() {
+    this->name = StringW(name);
+  }
+
+  std::unique_ptr<Transform> transform;
+  std::vector<std::unique_ptr<Component>> components;
+
+  Transform* get_transform() const {
+    return transform.get();
+  }
+
+  template <typename T> T GetComponent() const {
+    for (auto const& component : components) {
+      if (auto* casted = dynamic_cast<T>(component.get())) return casted;
+    }
+    return nullptr;
+  }
+
+  template <typename T> T AddComponent() {
+    auto& component = components.emplace_back(std::make_unique<std::remove_pointer_t<T>>());
+    component->gameObject = this;
+    return static_cast<T>(component.get());
+  }
+};
+
+inline Transform* Component::get_transform() const {
+  return gameObject ? gameObject->get_transform() : nullptr;
+}
+} // namespace UnityEngine
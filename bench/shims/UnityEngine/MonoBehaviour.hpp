@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Behaviour.hpp"
+#include "GameObject.hpp"
+#include "Transform.hpp"
+
+namespace UnityEngine {
+class MonoBehaviour : public Behaviour {
+public:
+  using Behaviour::Behaviour;
+};
+} // namespace UnityEngine
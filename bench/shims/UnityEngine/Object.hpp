@@ -0,0 +1,22 @@
+#pragma once
+
+#include "beatsaber-hook/shared/utils/typedefs.h"
+
+namespace UnityEngine {
+class Object : public Il2CppObject {
+public:
+  using Il2CppObject::Il2CppObject;
+
+  StringW name;
+  bool destroyed = false;
+
+  StringW get_name() const {
+    return name;
+  }
+
+  // Objects are owned by whoever created them on host; destroying only flags them.
+  static void Destroy(Object* object) {
+    if (object) object->destroyed = true;
+  }
+};
+} // namespace UnityEngine
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace UnityEngine {
+struct Quaternion {
+  float x = 0;
+  float y = 0;
+  float z = 0;
+  float w = 1;
+
+  constexpr Quaternion() = default;
+  constexpr Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+};
+} // namespace UnityEngine
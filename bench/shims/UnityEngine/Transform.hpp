@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Component.hpp"
+#include "Quaternion.hpp"
+#include "Vector3.hpp"
+
+namespace UnityEngine {
+/// Counts every transform write so benchmarks can report how many hierarchy invalidations Unity would have done.
+struct TransformWriteCounters {
+  uint64_t position = 0;
+  uint64_t localPosition = 0;
+  uint64_t rotation = 0;
+  uint64_t localRotation = 0;
+  uint64_t localScale = 0;
+  uint64_t positionAndRotation = 0;
+  uint64_t localPositionAndRotation = 0;
+
+  [[nodiscard]] uint64_t total() const {
+    return position + localPosition + rotation + localRotation + localScale + positionAndRotation +
+           localPositionAndRotation;
+  }
+};
+
+class Transform : public Component {
+public:
+  using Component::Component;
+
+  static inline TransformWriteCounters writes;
+
+  Transform* parent = nullptr;
+  Vector3 position;
+  Vector3 localPosition;
+  Quaternion rotation;
+  Quaternion localRotation;
+  Vector3 localScale{ 1, 1, 1 };
+
+  Transform* get_parent() const {
+    return parent;
+  }
+
+  Vector3 get_localPosition() {
+    return localPosition;
+  }
+  Quaternion get_localRotation() {
+    return localRotation;
+  }
+  Vector3 get_localScale() {
+    return localScale;
+  }
+
+  void set_position(Vector3 value) {
+    position = value;
+    writes.position++;
+  }
+  void set_localPosition(Vector3 value) {
+    localPosition = value;
+    writes.localPosition++;
+  }
+  void set_rotation(Quaternion value) {
+    rotation = value;
+    writes.rotation++;
+  }
+  void set_localRotation(Quaternion value) {
+    localRotation = value;
+    writes.localRotation++;
+  }
+  void set_localScale(Vector3 value) {
+    localScale = value;
+    writes.localScale++;
+  }
+  void SetPositionAndRotation(Vector3 position, Quaternion rotation) {
+    this->position = position;
+    this->rotation = rotation;
+    writes.positionAndRotation++;
+  }
+  void SetLocalPositionAndRotation(Vector3 localPosition, Quaternion localRotation) {
+    this->localPosition = localPosition;
+    this->localRotation = localRotation;
+    writes.localPositionAndRotation++;
+  }
+};
+} // namespace UnityEngine
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace UnityEngine {
+struct Vector2 {
+  float x = 0;
+  float y = 0;
+
+  constexpr Vector2() = default;
+  constexpr Vector2(float x, float y) : x(x), y(y) {}
+};
+} // namespace UnityEngine
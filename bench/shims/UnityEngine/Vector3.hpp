@@ -0,0 +1,12 @@
+#pragma once
+
+namespace UnityEngine {
+struct Vector3 {
+  float x = 0;
+  float y = 0;
+  float z = 0;
+
+  constexpr Vector3() = default;
+  constexpr Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+};
+} // namespace UnityEngine
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace UnityEngine {
+struct Vector4 {
+  float x = 0;
+  float y = 0;
+  float z = 0;
+  float w = 0;
+
+  constexpr Vector4() = default;
+  constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+};
+} // namespace UnityEngine
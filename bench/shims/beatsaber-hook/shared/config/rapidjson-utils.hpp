@@ -0,0 +1,8 @@
+#pragma once
+
+// the on-device header drags in most of the standard library, sources rely on that
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <rapidjson/document.h>
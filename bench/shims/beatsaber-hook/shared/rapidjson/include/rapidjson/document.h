@@ -0,0 +1,4 @@
+#pragma once
+
+// beatsaber-hook vendors rapidjson under this path; on host the system/fetched copy is used.
+#include <rapidjson/document.h>
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "typedefs.h"
+
+// Host stand-in for paper's logger. Errors go to stderr, everything else is dropped so benchmark
+// timings are not dominated by formatting.
+namespace Paper {
+enum class LogLevel { DBG, INF, WRN, ERR, CRIT, OFF };
+
+/// Messages below this level are dropped, benchmarks raise it around noisy setup code
+inline LogLevel hostLogThreshold = LogLevel::ERR;
+
+struct ConstLoggerContext {
+  char const* tag;
+
+  constexpr ConstLoggerContext(char const* tag) : tag(tag) {}
+
+  template <LogLevel lvl, typename... TArgs> void fmtLog(std::string_view str, TArgs&&... args) const {
+    if constexpr (lvl >= LogLevel::ERR) {
+      if (lvl < hostLogThreshold) return;
+      auto message = fmt::format(fmt::runtime(str), std::forward<TArgs>(args)...);
+      std::fprintf(stderr, "[%s] %s\n", tag, message.c_str());
+    }
+  }
+
+  template <typename... TArgs> void debug(std::string_view str, TArgs&&... args) const {
+    fmtLog<LogLevel::DBG>(str, std::forward<TArgs>(args)...);
+  }
+  template <typename... TArgs> void info(std::string_view str, TArgs&&... args) const {
+    fmtLog<LogLevel::INF>(str, std::forward<TArgs>(args)...);
+  }
+  template <typename... TArgs> void warn(std::string_view str, TArgs&&... args) const {
+    fmtLog<LogLevel::WRN>(str, std::forward<TArgs>(args)...);
+  }
+  template <typename... TArgs> void error(std::string_view str, TArgs&&... args) const {
+    fmtLog<LogLevel::ERR>(str, std::forward<TArgs>(args)...);
+  }
+  template <typename... TArgs> void critical(std::string_view str, TArgs&&... args) const {
+    fmtLog<LogLevel::CRIT>(str, std::forward<TArgs>(args)...);
+  }
+
+  void Backtrace(uint16_t) const {}
+};
+
+struct Logger {
+  static void Backtrace(std::string_view, uint16_t) {}
+};
+} // namespace Paper
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "typedefs.h"
+
+template <typename... TArgs> class UnorderedEventCallback {
+public:
+  void addCallback(std::function<void(TArgs...)> callback) {
+    callbacks.emplace_back(std::move(callback));
+  }
+
+  void invoke(TArgs... args) const {
+    for (auto const& callback : callbacks) {
+      callback(args...);
+    }
+  }
+
+  UnorderedEventCallback& operator+=(std::function<void(TArgs...)> callback) {
+    addCallback(std::move(callback));
+    return *this;
+  }
+
+private:
+  std::vector<std::function<void(TArgs...)>> callbacks;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+// Host stand-in for the il2cpp runtime types used by the Tracks core.
+// Only what the non-hook sources touch is modelled; nothing here talks to a runtime.
+
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+struct Il2CppClass {
+  char const* name;
+};
+
+struct Il2CppObject {
+  Il2CppClass* klass = nullptr;
+
+  Il2CppObject() = default;
+  explicit Il2CppObject(Il2CppClass* klass) : klass(klass) {}
+  virtual ~Il2CppObject() = default;
+};
+
+namespace il2cpp_utils {
+template <typename T> Il2CppClass* ClassOf() {
+  static Il2CppClass klass{ typeid(T).name() };
+  return &klass;
+}
+} // namespace il2cpp_utils
+
+#define classof(T) (::il2cpp_utils::ClassOf<std::remove_pointer_t<T>>())
+
+#define CRASH_UNLESS(expr)                                                                                             \
+  do {                                                                                                                 \
+    if (!(expr)) ::std::abort();                                                                                       \
+  } while (false)
+
+struct StringW {
+  std::string str;
+
+  StringW() = default;
+  StringW(std::string_view str) : str(str) {}
+
+  operator std::string() const {
+    return str;
+  }
+  bool operator==(std::string_view other) const {
+    return str == other;
+  }
+};
+
+namespace il2cpp_utils::il2cpp_type_check {
+/// Resolves a method to a plain function pointer, mirroring how the device build skips the icall thunk.
+template <auto method> struct FPtrWrapper;
+
+template <typename R, typename T, typename... TArgs, R (T::*method)(TArgs...)> struct FPtrWrapper<method> {
+  static R invoke(T* self, TArgs... args) {
+    return (self->*method)(args...);
+  }
+
+  static auto get() {
+    return &invoke;
+  }
+};
+} // namespace il2cpp_utils::il2cpp_type_check
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "beatsaber-hook/shared/utils/logging.hpp"
+
+class CJDLogger {
+public:
+  static constexpr auto Logger = Paper::ConstLoggerContext("CustomJSONData");
+};
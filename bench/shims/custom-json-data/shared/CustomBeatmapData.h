@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include "CustomEventData.h"
+#include "JSONWrapper.h"
+#include "GlobalNamespace/BeatmapObjectData.hpp"
+
+namespace CustomJSONData {
+class CustomNoteData : public GlobalNamespace::BeatmapObjectData {
+public:
+  CustomNoteData() : BeatmapObjectData(classof(CustomNoteData*)) {}
+
+  JSONWrapper* customData = nullptr;
+};
+
+class CustomObstacleData : public GlobalNamespace::BeatmapObjectData {
+public:
+  CustomObstacleData() : BeatmapObjectData(classof(CustomObstacleData*)) {}
+
+  JSONWrapper* customData = nullptr;
+};
+
+class CustomSliderData : public GlobalNamespace::BeatmapObjectData {
+public:
+  CustomSliderData() : BeatmapObjectData(classof(CustomSliderData*)) {}
+
+  JSONWrapper* customData = nullptr;
+};
+
+class CustomBeatmapData : public Il2CppObject {
+public:
+  CustomBeatmapData() : Il2CppObject(classof(CustomBeatmapData*)) {}
+
+  bool v2orEarlier = false;
+  JSONWrapper* customData = nullptr;
+  JSONWrapper* beatmapCustomData = nullptr;
+  JSONWrapper* levelCustomData = nullptr;
+
+  std::vector<GlobalNamespace::BeatmapObjectData*> beatmapObjectDatas;
+  std::vector<CustomEventData*> customEventDatas;
+};
+} // namespace CustomJSONData
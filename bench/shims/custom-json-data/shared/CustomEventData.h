@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string_view>
+
+#include "GlobalNamespace/BeatmapObjectData.hpp"
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+
+namespace CustomJSONData {
+class CustomEventData : public GlobalNamespace::BeatmapDataItem {
+public:
+  CustomEventData() : BeatmapDataItem(classof(CustomEventData*)) {}
+
+  std::string_view type;
+  size_t typeHash = 0;
+  rapidjson::Value const* data = nullptr;
+};
+} // namespace CustomJSONData
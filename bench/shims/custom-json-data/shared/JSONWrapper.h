@@ -0,0 +1,17 @@
+#pragma once
+
+#include <any>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+#include "beatsaber-hook/shared/utils/typedefs.h"
+
+namespace CustomJSONData {
+class JSONWrapper : public Il2CppObject {
+public:
+  std::optional<std::reference_wrapper<rapidjson::Value const>> value;
+  std::unordered_map<char, std::any> associatedData;
+};
+} // namespace CustomJSONData
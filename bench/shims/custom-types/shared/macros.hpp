@@ -0,0 +1,19 @@
+#pragma once
+
+// Host stand-ins for the custom-types registration macros. Types become plain C++ classes; nothing is registered.
+
+#define DECLARE_CLASS_CODEGEN(namespaze, name, baseT)                                                                  \
+  namespace namespaze {                                                                                                \
+  class name;                                                                                                          \
+  }                                                                                                                    \
+  class namespaze::name : public baseT
+
+#define DECLARE_INSTANCE_FIELD(type, name) type name
+
+#define DECLARE_INSTANCE_METHOD(ret, name, ...) ret name(__VA_ARGS__)
+
+#define DECLARE_SIMPLE_DTOR()
+
+#define DECLARE_DEFAULT_CTOR()
+
+#define DEFINE_TYPE(namespaze, name)
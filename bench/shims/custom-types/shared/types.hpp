@@ -0,0 +1,3 @@
+#pragma once
+
+#include "beatsaber-hook/shared/utils/typedefs.h"
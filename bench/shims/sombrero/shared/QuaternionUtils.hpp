@@ -0,0 +1,24 @@
+#pragma once
+
+#include "UnityEngine/Quaternion.hpp"
+#include "Vector3Utils.hpp"
+
+namespace Sombrero {
+struct FastQuaternion : public UnityEngine::Quaternion {
+  constexpr FastQuaternion(float x = 0, float y = 0, float z = 0, float w = 1) : UnityEngine::Quaternion(x, y, z, w) {}
+  constexpr FastQuaternion(UnityEngine::Quaternion const& other) : UnityEngine::Quaternion(other) {}
+
+  static constexpr FastQuaternion identity() {
+    return {};
+  }
+
+  constexpr FastQuaternion operator*(FastQuaternion const& b) const {
+    return { w * b.x + x * b.w + y * b.z - z * b.y, w * b.y + y * b.w + z * b.x - x * b.z,
+             w * b.z + z * b.w + x * b.y - y * b.x, w * b.w - x * b.x - y * b.y - z * b.z };
+  }
+
+  static constexpr float Dot(FastQuaternion const& a, FastQuaternion const& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+  }
+};
+} // namespace Sombrero
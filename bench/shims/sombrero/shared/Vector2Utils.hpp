@@ -0,0 +1,20 @@
+#pragma once
+
+#include "UnityEngine/Vector2.hpp"
+
+namespace Sombrero {
+struct FastVector2 : public UnityEngine::Vector2 {
+  constexpr FastVector2(float x = 0, float y = 0) : UnityEngine::Vector2(x, y) {}
+  constexpr FastVector2(UnityEngine::Vector2 const& other) : UnityEngine::Vector2(other) {}
+
+  constexpr FastVector2 operator+(FastVector2 const& b) const {
+    return { x + b.x, y + b.y };
+  }
+  constexpr FastVector2 operator-(FastVector2 const& b) const {
+    return { x - b.x, y - b.y };
+  }
+  constexpr FastVector2 operator*(float b) const {
+    return { x * b, y * b };
+  }
+};
+} // namespace Sombrero
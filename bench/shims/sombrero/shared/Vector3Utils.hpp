@@ -0,0 +1,34 @@
+#pragma once
+
+#include "UnityEngine/Vector3.hpp"
+
+namespace Sombrero {
+struct FastVector3 : public UnityEngine::Vector3 {
+  constexpr FastVector3(float x = 0, float y = 0, float z = 0) : UnityEngine::Vector3(x, y, z) {}
+  constexpr FastVector3(UnityEngine::Vector3 const& other) : UnityEngine::Vector3(other) {}
+
+  constexpr FastVector3 operator+(FastVector3 const& b) const {
+    return { x + b.x, y + b.y, z + b.z };
+  }
+  constexpr FastVector3 operator-(FastVector3 const& b) const {
+    return { x - b.x, y - b.y, z - b.z };
+  }
+  // component-wise, same as Vector3.Scale
+  constexpr FastVector3 operator*(FastVector3 const& b) const {
+    return { x * b.x, y * b.y, z * b.z };
+  }
+  constexpr FastVector3 operator*(float b) const {
+    return { x * b, y * b, z * b };
+  }
+  constexpr FastVector3& operator+=(FastVector3 const& b) {
+    return *this = *this + b;
+  }
+  constexpr FastVector3& operator*=(float b) {
+    return *this = *this * b;
+  }
+
+  static constexpr FastVector3 LerpUnclamped(FastVector3 const& a, FastVector3 const& b, float t) {
+    return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t };
+  }
+};
+} // namespace Sombrero
@@ -0,0 +1,125 @@
+#include "BenchCommon.hpp"
+
+#include <array>
+
+#include <fmt/format.h>
+
+namespace TracksBench {
+
+char const* EasingName(Functions function) {
+  static constexpr std::array<char const*, Functions::EaseInOutBounce + 1> names = {
+    "easeLinear",     "easeStep",       "easeInQuad",       "easeOutQuad",     "easeInOutQuad",  "easeInCubic",
+    "easeOutCubic",   "easeInOutCubic", "easeInQuart",      "easeOutQuart",    "easeInOutQuart", "easeInQuint",
+    "easeOutQuint",   "easeInOutQuint", "easeInSine",       "easeOutSine",     "easeInOutSine",  "easeInCirc",
+    "easeOutCirc",    "easeInOutCirc",  "easeInExpo",       "easeOutExpo",     "easeInOutExpo",  "easeInElastic",
+    "easeOutElastic", "easeInOutElastic", "easeInBack",     "easeOutBack",     "easeInOutBack",  "easeInBounce",
+    "easeOutBounce",  "easeInOutBounce"
+  };
+  return names[function];
+}
+
+void BeatmapFixture::Animate(TrackW const& track, Tracks::ffi::PropertyNames name,
+                             PointDefinitionW const& pointDefinition, float duration, float songTime) {
+  Tracks::ffi::CEventData cEventData = {
+    .raw_duration = duration,
+    .easing = Functions::EaseLinear,
+    .repeat = 0,
+    .start_time = songTime,
+    .event_type =
+        Tracks::ffi::CEventType{
+            .ty = Tracks::ffi::CEventTypeEnum::AnimateTrack,
+            .property_id = { .property_name = name },
+            .property_id_type = Tracks::ffi::CEventPropertyIdType::PropertyName,
+        },
+    .track_key = track.track,
+    .point_data_ptr = pointDefinition,
+  };
+  auto& eventData =
+      events.emplace_back(std::make_shared<TracksAD::EventDataW>(Tracks::ffi::event_data_to_rust(&cEventData)));
+  beatmapAD.GetCoroutineManager()->StartCoroutine(100, songTime, *beatmapAD.GetBaseProviderContext(),
+                                                  *beatmapAD.GetTracksHolder(), *eventData);
+}
+
+void BeatmapFixture::Set(TrackW const& track, Tracks::ffi::PropertyNames name, Tracks::ffi::WrapBaseValueType type,
+                         char const* pointsJson) {
+  rapidjson::Document doc;
+  doc.Parse(pointsJson);
+  auto const& pointDefinition = pointDefinitions.emplace_back(doc, type, beatmapAD.GetBaseProviderContext());
+  Animate(track, name, pointDefinition, 0);
+}
+
+void BeatmapFixture::PollCoroutines(float songTime) {
+  beatmapAD.GetCoroutineManager()->PollCoroutines(songTime, *beatmapAD.GetBaseProviderContext(),
+                                                  *beatmapAD.GetTracksHolder());
+}
+
+static int ComponentCount(Tracks::ffi::WrapBaseValueType type) {
+  switch (type) {
+  case Tracks::ffi::WrapBaseValueType::Float:
+    return 1;
+  case Tracks::ffi::WrapBaseValueType::Vec4:
+    return 4;
+  default:
+    // quaternions are authored as euler angles
+    return 3;
+  }
+}
+
+std::string MakePointsJson(PointsSpec const& spec) {
+  int components = ComponentCount(spec.type);
+
+  std::string json = "[";
+  for (int i = 0; i < spec.count; i++) {
+    float time = spec.count > 1 ? float(i) / float(spec.count - 1) : 0.0f;
+
+    json += i == 0 ? "[" : ",[";
+    if (spec.baseProvider && i % 2 == 1) {
+      json += fmt::format("\"{}\"", spec.baseProvider);
+    } else {
+      for (int c = 0; c < components; c++) {
+        json += fmt::format("{}{}", c == 0 ? "" : ",", float((i * 7 + c * 3) % 11) - 5.0f);
+      }
+    }
+    json += fmt::format(",{}", time);
+
+    if (spec.easing != Functions::EaseLinear) {
+      json += fmt::format(",\"{}\"", EasingName(spec.easing));
+    }
+    if (spec.spline) {
+      json += ",\"splineCatmullRom\"";
+    }
+    json += "]";
+  }
+  json += "]";
+
+  return json;
+}
+
+PointDefinitionW MakePointDefinition(PointsSpec const& spec,
+                                     std::shared_ptr<TracksAD::BaseProviderContextW> const& context) {
+  rapidjson::Document doc;
+  doc.Parse(MakePointsJson(spec).c_str());
+
+  return PointDefinitionW(doc, spec.type, context);
+}
+
+void ResetFfiCounters() {
+#ifdef TRACKS_FFI_ACCOUNTING
+  Tracks::FfiAccounting::Reset();
+#endif
+}
+
+void ReportFfiCounters([[maybe_unused]] benchmark::State& state, [[maybe_unused]] double frames) {
+#ifdef TRACKS_FFI_ACCOUNTING
+  uint64_t calls = 0;
+  uint64_t ns = 0;
+  for (auto const& report : Tracks::FfiAccounting::Snapshot()) {
+    calls += report.calls;
+    ns += report.ns;
+  }
+  state.counters["ffi_calls/frame"] = double(calls) / frames;
+  state.counters["ffi_us/frame"] = double(ns) / frames / 1000.0;
+#endif
+}
+
+} // namespace TracksBench
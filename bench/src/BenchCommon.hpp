@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "AssociatedData.h"
+#include "Animation/PointDefinition.h"
+
+namespace TracksBench {
+
+/// Beatmap-level state the core expects to exist: holder, base provider context and coroutine manager.
+/// Mirrors what BeatmapAssociatedData owns on device without needing a CustomBeatmapData.
+struct BeatmapFixture {
+  TracksAD::BeatmapAssociatedData beatmapAD;
+  // kept alive while their coroutines run
+  std::vector<PointDefinitionW> pointDefinitions;
+  std::vector<std::shared_ptr<TracksAD::EventDataW>> events;
+
+  TrackW AddTrack(std::string const& name) {
+    return beatmapAD.getTrack(name);
+  }
+
+  /// Starts an AnimateTrack event of name on track, applied by the next PollCoroutines
+  void Animate(TrackW const& track, Tracks::ffi::PropertyNames name, PointDefinitionW const& pointDefinition,
+               float duration, float songTime = 0);
+  /// Animate with a definition parsed from pointsJson over no time, i.e. sets the property to its last point
+  void Set(TrackW const& track, Tracks::ffi::PropertyNames name, Tracks::ffi::WrapBaseValueType type,
+           char const* pointsJson);
+  void PollCoroutines(float songTime);
+};
+
+/// Shape of a generated point definition
+struct PointsSpec {
+  int count = 2;
+  Tracks::ffi::WrapBaseValueType type = Tracks::ffi::WrapBaseValueType::Vec3;
+  Functions easing = Functions::EaseLinear;
+  bool spline = false;
+  // every other point references this base provider value when set
+  char const* baseProvider = nullptr;
+};
+
+/// JSON name of an easing, inverse of FunctionFromStr
+char const* EasingName(Functions function);
+
+/// Point definition JSON in the v3 array form, points evenly spaced over [0, 1]
+std::string MakePointsJson(PointsSpec const& spec);
+
+PointDefinitionW MakePointDefinition(PointsSpec const& spec,
+                                     std::shared_ptr<TracksAD::BaseProviderContextW> const& context);
+
+/// Adds FFI calls and time per frame as counters when built with TRACKS_FFI_ACCOUNTING, call ResetFfiCounters before
+/// the timed loop
+void ResetFfiCounters();
+void ReportFfiCounters(benchmark::State& state, double frames);
+
+} // namespace TracksBench
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include "AssociatedData.h"
+#include "SyntheticMap.hpp"
+
+using namespace TracksBench;
+
+// Map load: TracksAD::readBeatmapDataAD end to end, and each of its phases on its own.
+// args: size in percent of the default SyntheticMapSpec (100k notes, 20k events, 4k point definitions), v2
+
+namespace {
+
+SyntheticMapSpec ScaledSpec(benchmark::State const& state) {
+  SyntheticMapSpec spec;
+  auto scale = [&](int value) { return int(int64_t(value) * state.range(0) / 100); };
+  spec.notes = scale(spec.notes);
+  spec.events = scale(spec.events);
+  spec.pointDefinitions = scale(spec.pointDefinitions);
+  spec.tracks = std::max(1, scale(spec.tracks));
+  spec.v2 = state.range(1) != 0;
+  return spec;
+}
+
+void SetCounters(benchmark::State& state, SyntheticMap const& map, int64_t itemsPerIteration) {
+  state.counters["notes"] = map.spec.notes;
+  state.counters["events"] = map.spec.events;
+  state.counters["pointDefinitions"] = map.spec.pointDefinitions;
+  state.SetItemsProcessed(state.iterations() * itemsPerIteration);
+}
+
+void ReadMap(benchmark::State& state, SyntheticMap& map) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    map.Reset();
+    state.ResumeTiming();
+
+    TracksAD::readBeatmapDataAD(map.GetBeatmapData());
+  }
+  map.Reset();
+}
+
+void LoadBenchmarkArgs(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({ "size%", "v2" })->ArgsProduct({ { 10, 100 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+static void BM_ReadBeatmapDataAD(benchmark::State& state) {
+  SyntheticMap map(ScaledSpec(state));
+  ReadMap(state, map);
+  SetCounters(state, map, map.spec.notes + map.spec.events);
+
+  // memory of one load, the converted JSON counter is process wide so take the growth of a single read
+  auto convertedBefore = GetConvertRapidjsonStats().bytes;
+  TracksAD::readBeatmapDataAD(map.GetBeatmapData());
+  auto memoryStats = TracksAD::getBeatmapAD(map.GetBeatmapData()->customData).GetMemoryStats();
+  state.counters["ad_KiB_est"] = double(memoryStats.TotalBytes()) / 1024.0;
+  state.counters["events_KiB_est"] = double(memoryStats.eventData.bytes + memoryStats.rustEventData.bytes) / 1024.0;
+  state.counters["json_KiB_est"] = double(memoryStats.convertedJson.bytes - convertedBefore) / 1024.0;
+  map.Reset();
+}
+BENCHMARK(BM_ReadBeatmapDataAD)->Apply(LoadBenchmarkArgs);
+
+// phase 1: pointDefinitions registration only
+static void BM_LoadPhasePointDefinitions(benchmark::State& state) {
+  auto spec = ScaledSpec(state);
+  spec.notes = 0;
+  spec.events = 0;
+  SyntheticMap map(spec);
+  ReadMap(state, map);
+  SetCounters(state, map, map.spec.pointDefinitions);
+}
+BENCHMARK(BM_LoadPhasePointDefinitions)->Apply(LoadBenchmarkArgs);
+
+// phase 2: object track arrays, i.e. getTrack for every note
+static void BM_LoadPhaseObjectTracks(benchmark::State& state) {
+  auto spec = ScaledSpec(state);
+  spec.pointDefinitions = 0;
+  spec.events = 0;
+  SyntheticMap map(spec);
+  ReadMap(state, map);
+  SetCounters(state, map, map.spec.notes);
+}
+BENCHMARK(BM_LoadPhaseObjectTracks)->Apply(LoadBenchmarkArgs);
+
+// phase 3: LoadTrackEvent for every custom event, on a beatmap that already went through phases 1 and 2
+static void BM_LoadPhaseTrackEvents(benchmark::State& state) {
+  SyntheticMap map(ScaledSpec(state));
+  map.SetEventsAttached(false);
+
+  auto* beatmapData = map.GetBeatmapData();
+  for (auto _ : state) {
+    state.PauseTiming();
+    map.Reset();
+    TracksAD::readBeatmapDataAD(beatmapData);
+    auto& beatmapAD = TracksAD::getBeatmapAD(beatmapData->customData);
+    state.ResumeTiming();
+
+    for (auto* customEventData : map.GetEvents()) {
+      TracksAD::LoadTrackEvent(customEventData, beatmapAD, beatmapData->v2orEarlier);
+    }
+  }
+  map.Reset();
+
+  SetCounters(state, map, map.spec.events);
+}
+BENCHMARK(BM_LoadPhaseTrackEvents)->Apply(LoadBenchmarkArgs);
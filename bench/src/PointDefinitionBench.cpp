@@ -0,0 +1,420 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "BenchCommon.hpp"
+
+#include "Animation/PointDefinitionBatch.hpp"
+
+using namespace TracksBench;
+using Tracks::ffi::WrapBaseValueType;
+
+// PointDefinitionW::Interpolate and the typed wrappers, i.e. tracks_interpolate_base_point_definition.
+// Times sweep [0, 1] so every segment of the definition gets hit, results are ns/call.
+
+namespace {
+
+constexpr float timeStep = 1.0f / 1021.0f;
+
+char const* BaseProviderFor(WrapBaseValueType type) {
+  switch (type) {
+  case WrapBaseValueType::Vec3:
+    return "baseHeadLocalPosition";
+  case WrapBaseValueType::Quat:
+    return "baseHeadLocalRotation";
+  case WrapBaseValueType::Vec4:
+    return "baseNote0Color";
+  default:
+    return nullptr;
+  }
+}
+
+/// Fixture with every base provider value the generated definitions may reference
+struct PointDefinitionFixture : BeatmapFixture {
+  PointDefinitionFixture() {
+    auto context = beatmapAD.GetBaseProviderContext();
+    context->SetVector3Value("baseHeadLocalPosition", { 0.1f, 1.7f, 0.2f });
+    context->SetQuatValue("baseHeadLocalRotation", { 0.0f, 0.38f, 0.0f, 0.92f });
+    context->SetVector4Value("baseNote0Color", { 0.8f, 0.1f, 0.1f, 1.0f });
+  }
+
+  PointDefinitionW Make(int count, WrapBaseValueType type, Functions easing, bool spline, bool base) {
+    PointsSpec spec{ .count = count, .type = type, .easing = easing, .spline = spline };
+    if (base) spec.baseProvider = BaseProviderFor(type);
+    return MakePointDefinition(spec, beatmapAD.GetBaseProviderContext());
+  }
+};
+
+void SetCounters(benchmark::State& state, PointDefinitionW const& pointDefinition) {
+  state.counters["points"] = double(pointDefinition.count());
+  state.counters["base"] = pointDefinition.hasBaseProvider() ? 1 : 0;
+  state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+// args: point count, spline, base provider
+static void BM_PointDefinitionInterpolate(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  auto pointDefinition = fixture.Make(int(state.range(0)), WrapBaseValueType::Vec3, Functions::EaseLinear,
+                                      state.range(1) != 0, state.range(2) != 0);
+
+  float t = 0;
+  bool last;
+  for (auto _ : state) {
+    t += timeStep;
+    if (t > 1) t = 0;
+    benchmark::DoNotOptimize(pointDefinition.Interpolate(t, last));
+  }
+  SetCounters(state, pointDefinition);
+}
+BENCHMARK(BM_PointDefinitionInterpolate)
+    ->ArgNames({ "points", "spline", "base" })
+    ->ArgsProduct({ benchmark::CreateRange(2, 10000, 4), { 0, 1 }, { 0, 1 } });
+
+// args: easing, 16 points
+static void BM_PointDefinitionEasing(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  auto easing = static_cast<Functions>(state.range(0));
+  auto pointDefinition = fixture.Make(16, WrapBaseValueType::Vec3, easing, false, false);
+  state.SetLabel(EasingName(easing));
+
+  float t = 0;
+  bool last;
+  for (auto _ : state) {
+    t += timeStep;
+    if (t > 1) t = 0;
+    benchmark::DoNotOptimize(pointDefinition.Interpolate(t, last));
+  }
+  SetCounters(state, pointDefinition);
+}
+BENCHMARK(BM_PointDefinitionEasing)->DenseRange(Functions::EaseLinear, Functions::EaseInOutBounce);
+
+// typed wrappers, args: point count, base provider
+template <WrapBaseValueType type, auto interpolate>
+static void BM_PointDefinitionTyped(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  auto pointDefinition = fixture.Make(int(state.range(0)), type, Functions::EaseLinear, false, state.range(1) != 0);
+
+  float t = 0;
+  bool last;
+  for (auto _ : state) {
+    t += timeStep;
+    if (t > 1) t = 0;
+    benchmark::DoNotOptimize((pointDefinition.*interpolate)(t, last));
+  }
+  SetCounters(state, pointDefinition);
+}
+
+using InterpolateVec3Fn = NEVector::Vector3 (PointDefinitionW::*)(float, bool&) const;
+using InterpolateQuaternionFn = NEVector::Quaternion (PointDefinitionW::*)(float, bool&) const;
+using InterpolateVector4Fn = NEVector::Vector4 (PointDefinitionW::*)(float, bool&) const;
+using InterpolateLinearFn = float (PointDefinitionW::*)(float, bool&) const;
+
+BENCHMARK_TEMPLATE(BM_PointDefinitionTyped, WrapBaseValueType::Vec3,
+                   static_cast<InterpolateVec3Fn>(&PointDefinitionW::InterpolateVec3))
+    ->Name("BM_InterpolateVec3")
+    ->ArgNames({ "points", "base" })
+    ->ArgsProduct({ benchmark::CreateRange(2, 10000, 8), { 0, 1 } });
+BENCHMARK_TEMPLATE(BM_PointDefinitionTyped, WrapBaseValueType::Quat,
+                   static_cast<InterpolateQuaternionFn>(&PointDefinitionW::InterpolateQuaternion))
+    ->Name("BM_InterpolateQuaternion")
+    ->ArgNames({ "points", "base" })
+    ->ArgsProduct({ benchmark::CreateRange(2, 10000, 8), { 0, 1 } });
+BENCHMARK_TEMPLATE(BM_PointDefinitionTyped, WrapBaseValueType::Vec4,
+                   static_cast<InterpolateVector4Fn>(&PointDefinitionW::InterpolateVector4))
+    ->Name("BM_InterpolateVector4")
+    ->ArgNames({ "points", "base" })
+    ->ArgsProduct({ benchmark::CreateRange(2, 10000, 8), { 0, 1 } });
+BENCHMARK_TEMPLATE(BM_PointDefinitionTyped, WrapBaseValueType::Float,
+                   static_cast<InterpolateLinearFn>(&PointDefinitionW::InterpolateLinear))
+    ->Name("BM_InterpolateLinear")
+    ->ArgNames({ "points", "base" })
+    ->ArgsProduct({ benchmark::CreateRange(2, 10000, 8), { 0 } });
+
+// PointDefinitionW from an already parsed document, i.e. the JSON conversion plus tracks_make_base_point_definition.
+// args: point count
+static void BM_PointDefinitionBuild(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  PointsSpec spec{ .count = int(state.range(0)) };
+  rapidjson::Document doc;
+  doc.Parse(MakePointsJson(spec).c_str());
+  auto context = fixture.beatmapAD.GetBaseProviderContext();
+
+  for (auto _ : state) {
+    PointDefinitionW pointDefinition(doc, spec.type, context);
+    benchmark::DoNotOptimize(pointDefinition);
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  // what the MainMenu scene change does, the blocks sized for this definition have to go
+  auto& arena = JsonArena::ForThread();
+  state.counters["arena_KiB"] = double(arena.Capacity()) / 1024;
+  JsonArena::ReleaseAll();
+  if (arena.Capacity() != 0) {
+    state.SkipWithError("JsonArena::ReleaseAll kept the blocks");
+  }
+}
+BENCHMARK(BM_PointDefinitionBuild)->ArgNames({ "points" })->RangeMultiplier(8)->Range(2, 4096);
+
+// InterpolateVec3Batch against one InterpolateVec3 per sample, args: samples, definitions, batched.
+// Samples are sorted by definition and each definition is sampled at one time, like notes sharing an animation
+static void BM_InterpolateVec3Samples(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  auto sampleCount = size_t(state.range(0));
+  auto definitionCount = size_t(state.range(1));
+  bool batched = state.range(2) != 0;
+
+  std::vector<PointDefinitionW> definitions;
+  for (size_t i = 0; i < definitionCount; i++) {
+    definitions.push_back(fixture.Make(8, WrapBaseValueType::Vec3, Functions::EaseLinear, false, false));
+  }
+  std::vector<Tracks::PointSample> samples;
+  for (size_t i = 0; i < sampleCount; i++) {
+    auto definition = i * definitionCount / sampleCount;
+    samples.push_back({ &definitions[definition], float(definition) / float(definitionCount) });
+  }
+  std::vector<float> xs(sampleCount), ys(sampleCount), zs(sampleCount);
+
+  for (auto _ : state) {
+    if (batched) {
+      Tracks::InterpolateVec3Batch(samples, xs, ys, zs);
+    } else {
+      for (size_t i = 0; i < sampleCount; i++) {
+        auto value = samples[i].definition->InterpolateVec3(samples[i].time);
+        xs[i] = value.x;
+        ys[i] = value.y;
+        zs[i] = value.z;
+      }
+    }
+    benchmark::DoNotOptimize(xs.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * sampleCount);
+}
+BENCHMARK(BM_InterpolateVec3Samples)
+    ->ArgNames({ "samples", "definitions", "batched" })
+    ->ArgsProduct({ { 1024 }, { 16, 1024 }, { 0, 1 } });
+
+// InterpolateVec3Batch over baked adaptive tables with samples in random order, against one InterpolateVec3 per
+// sample. Fails unless the batch, which groups them and walks each table forward, gives the same values in the order
+// of the samples. args: definitions, batched
+static void BM_InterpolateVec3SamplesBaked(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  constexpr size_t sampleCount = 4096;
+  auto definitionCount = size_t(state.range(0));
+  bool batched = state.range(1) != 0;
+
+  std::vector<PointDefinitionW> definitions;
+  for (size_t i = 0; i < definitionCount; i++) {
+    definitions.push_back(fixture.Make(512, WrapBaseValueType::Vec3, Functions::EaseInOutSine, false, false));
+    if (!definitions.back().Bake({ .maxSamples = 1 << 22 })) {
+      state.SkipWithError("not bakeable within the tolerance");
+      return;
+    }
+  }
+  std::vector<Tracks::PointSample> samples;
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<size_t> definition(0, definitionCount - 1);
+  std::uniform_real_distribution<float> time(0, 1);
+  for (size_t i = 0; i < sampleCount; i++) {
+    samples.push_back({ &definitions[definition(rng)], time(rng) });
+  }
+  std::vector<float> xs(sampleCount), ys(sampleCount), zs(sampleCount);
+
+  for (auto _ : state) {
+    if (batched) {
+      Tracks::InterpolateVec3Batch(samples, xs, ys, zs);
+    } else {
+      for (size_t i = 0; i < sampleCount; i++) {
+        auto value = samples[i].definition->InterpolateVec3(samples[i].time);
+        xs[i] = value.x;
+        ys[i] = value.y;
+        zs[i] = value.z;
+      }
+    }
+    benchmark::DoNotOptimize(xs.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * sampleCount);
+
+  for (size_t i = 0; i < sampleCount; i++) {
+    auto expected = samples[i].definition->InterpolateVec3(samples[i].time);
+    if (xs[i] != expected.x || ys[i] != expected.y || zs[i] != expected.z) {
+      state.SkipWithError("batch differs from interpolating each sample");
+      break;
+    }
+  }
+}
+BENCHMARK(BM_InterpolateVec3SamplesBaked)
+    ->ArgNames({ "definitions", "batched" })
+    ->ArgsProduct({ { 1, 16, 256 }, { 0, 1 } });
+
+// BakedPointDefinition against the definition it was baked from, args: point count, baked
+static void BM_BakedInterpolateVec3(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  auto pointDefinition =
+      fixture.Make(int(state.range(0)), WrapBaseValueType::Vec3, Functions::EaseInOutSine, false, false);
+  if (state.range(1) != 0 && !pointDefinition.Bake({ .maxResolution = 1 << 16 })) {
+    state.SkipWithError("not bakeable within the tolerance");
+    return;
+  }
+
+  float t = 0;
+  bool last;
+  for (auto _ : state) {
+    t += timeStep;
+    if (t > 1) t = 0;
+    benchmark::DoNotOptimize(pointDefinition.InterpolateVec3(t, last));
+  }
+  if (auto const* baked = pointDefinition.GetBaked()) {
+    state.counters["resolution"] = baked->Resolution();
+    state.counters["error"] = baked->MeasuredError();
+  }
+  SetCounters(state, pointDefinition);
+}
+BENCHMARK(BM_BakedInterpolateVec3)
+    ->ArgNames({ "points", "baked" })
+    ->ArgsProduct({ benchmark::CreateRange(2, 512, 8), { 0, 1 } });
+
+// PointDefinitionCursor on an adaptive table against searching it and tracks_rs, args: point count, mode.
+// Mode 0 is not baked, 1 searches the baked table for every sample, 2 walks it with a cursor
+static void BM_CursorInterpolateVec3(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  auto pointDefinition =
+      fixture.Make(int(state.range(0)), WrapBaseValueType::Vec3, Functions::EaseInOutSine, false, false);
+  auto mode = state.range(1);
+  if (mode != 0 && !pointDefinition.Bake({ .maxSamples = 1 << 22 })) {
+    state.SkipWithError("not bakeable within the tolerance");
+    return;
+  }
+  PointDefinitionCursor cursor(pointDefinition);
+
+  float t = 0;
+  bool last;
+  for (auto _ : state) {
+    t += timeStep;
+    if (t > 1) t = 0;
+    if (mode == 2) {
+      benchmark::DoNotOptimize(cursor.InterpolateVec3(t, last));
+    } else {
+      benchmark::DoNotOptimize(pointDefinition.InterpolateVec3(t, last));
+    }
+  }
+  if (auto const* baked = pointDefinition.GetBaked()) {
+    state.counters["resolution"] = baked->Resolution();
+    state.counters["adaptive"] = baked->IsAdaptive();
+  }
+  SetCounters(state, pointDefinition);
+}
+BENCHMARK(BM_CursorInterpolateVec3)
+    ->ArgNames({ "points", "mode" })
+    ->ArgsProduct({ { 64, 512, 4096 }, { 0, 1, 2 } });
+
+// Baked tables against the definition they were baked from, a sorted sweep through a cursor and random times
+// through the search. Fails when a sample is off by more than twice the larger of the measured error and the
+// tolerance, the measured error is only taken at the middle and quarters of each segment.
+// args: point count, step easing, adaptive
+static void BM_BakedAccuracyVec3(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  auto easing = state.range(1) != 0 ? Functions::EaseStep : Functions::EaseInOutSine;
+  auto pointDefinition = fixture.Make(int(state.range(0)), WrapBaseValueType::Vec3, easing, false, false);
+  BakedPointDefinition::Options options{ .maxResolution = 1 << 16,
+                                         .maxSamples = state.range(2) != 0 ? 1u << 22 : 0u };
+  if (!pointDefinition.Bake(options)) {
+    state.SkipWithError("not bakeable within the tolerance");
+    return;
+  }
+  auto const* baked = pointDefinition.GetBaked();
+  PointDefinitionCursor cursor(pointDefinition);
+
+  constexpr size_t sampleCount = 4096;
+  std::vector<float> sorted(sampleCount);
+  std::vector<float> shuffled(sampleCount);
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> distribution(0, 1);
+  for (size_t i = 0; i < sampleCount; i++) {
+    sorted[i] = float(i) / float(sampleCount - 1);
+    shuffled[i] = distribution(rng);
+  }
+
+  // the untyped Interpolate is never baked
+  auto difference = [&](float time, NEVector::Vector3 value) {
+    auto expected = pointDefinition.Interpolate(time).value.vec3;
+    return std::max({ std::abs(value.x - expected.x), std::abs(value.y - expected.y), std::abs(value.z - expected.z) });
+  };
+
+  float error = 0;
+  bool last;
+  for (auto _ : state) {
+    cursor.Reset();
+    for (float time : sorted) {
+      error = std::max(error, difference(time, cursor.InterpolateVec3(time, last)));
+    }
+    for (float time : shuffled) {
+      error = std::max(error, difference(time, pointDefinition.InterpolateVec3(time, last)));
+    }
+  }
+
+  state.counters["error"] = error;
+  state.counters["measured"] = baked->MeasuredError();
+  state.counters["resolution"] = baked->Resolution();
+  state.SetItemsProcessed(state.iterations() * sampleCount * 2);
+  if (error > 2 * std::max(baked->MeasuredError(), options.tolerance)) {
+    state.SkipWithError("baked table is further off than its measured error");
+  }
+}
+BENCHMARK(BM_BakedAccuracyVec3)
+    ->ArgNames({ "points", "step", "adaptive" })
+    ->Args({ 2, 0, 0 })
+    ->Args({ 8, 0, 0 })
+    ->Args({ 64, 0, 1 })
+    ->Args({ 512, 0, 1 })
+    ->Args({ 4096, 0, 1 })
+    ->Args({ 64, 1, 1 })
+    ->Args({ 512, 1, 1 });
+
+// A cursor over a definition nobody baked, forward, back to the start and past the end. Fails unless the cursor
+// baked its own copy, left the definition it was made from alone and stays within twice the table's measured error
+// of the untyped Interpolate. args: point count
+static void BM_CursorUnbakedVec3(benchmark::State& state) {
+  PointDefinitionFixture fixture;
+  auto pointDefinition =
+      fixture.Make(int(state.range(0)), WrapBaseValueType::Vec3, Functions::EaseInOutSine, false, false);
+  PointDefinitionCursor cursor(pointDefinition);
+  auto const* baked = cursor.GetDefinition().GetBaked();
+  if (!baked || pointDefinition.GetBaked()) {
+    state.SkipWithError("cursor did not bake its own table");
+    return;
+  }
+
+  std::vector<float> times;
+  for (int pass = 0; pass < 2; pass++) {
+    for (float time = 0; time <= 1.1f; time += timeStep) {
+      times.push_back(time);
+    }
+  }
+
+  float error = 0;
+  bool last;
+  for (auto _ : state) {
+    for (float time : times) {
+      auto value = cursor.InterpolateVec3(time, last);
+      bool expectedLast;
+      auto expected = pointDefinition.Interpolate(time, expectedLast).value.vec3;
+      error = std::max(
+          { error, std::abs(value.x - expected.x), std::abs(value.y - expected.y), std::abs(value.z - expected.z) });
+      if (last != expectedLast) error = INFINITY;
+    }
+  }
+
+  state.counters["error"] = error;
+  state.counters["measured"] = baked->MeasuredError();
+  state.counters["adaptive"] = baked->IsAdaptive();
+  state.SetItemsProcessed(state.iterations() * times.size());
+  if (error > 2 * std::max(baked->MeasuredError(), PointDefinitionCursor::bakeOptions.tolerance)) {
+    state.SkipWithError("cursor is further off than its table's measured error");
+  }
+}
+BENCHMARK(BM_CursorUnbakedVec3)->ArgNames({ "points" })->Arg(8)->Arg(512)->Arg(4096);
@@ -0,0 +1,14 @@
+#include <benchmark/benchmark.h>
+
+#include "Profiling.h"
+
+// Cost of one profiling zone, configure with -DTRACKS_PROFILING=ON to measure it (otherwise the zone compiles out)
+
+static void BM_ProfileZone(benchmark::State& state) {
+  for (auto _ : state) {
+    TRACKS_PROFILE_ZONE("BM_ProfileZone");
+    benchmark::ClobberMemory();
+  }
+  Tracks::Profiling::Clear();
+}
+BENCHMARK(BM_ProfileZone);
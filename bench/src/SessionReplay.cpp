@@ -0,0 +1,65 @@
+#include "SessionReplay.hpp"
+
+namespace TracksBench {
+
+SessionReplay::SessionReplay(Tracks::SessionRecording::Session session) : session(std::move(session)) {
+  beatmapDocument.Parse(this->session.beatmapJson.c_str());
+  CRASH_UNLESS(!beatmapDocument.HasParseError());
+
+  beatmapData.v2orEarlier = this->session.v2;
+  beatmapCustomData.value = beatmapDocument;
+  beatmapData.customData = &beatmapCustomData;
+
+  for (auto const& recordedEvent : this->session.events) {
+    auto& document = eventDocuments.emplace_back(std::make_unique<rapidjson::Document>());
+    document->Parse(recordedEvent.json.c_str());
+    CRASH_UNLESS(!document->HasParseError());
+
+    auto& event = events.emplace_back(std::make_unique<CustomJSONData::CustomEventData>());
+    event->time = recordedEvent.time;
+    event->type = recordedEvent.type;
+    event->typeHash = std::hash<std::string_view>()(event->type);
+    event->data = document.get();
+  }
+}
+
+void SessionReplay::Reset() {
+  beatmapCustomData.associatedData.clear();
+  TracksAD::clearEventADs();
+
+  TracksAD::readBeatmapDataAD(&beatmapData);
+  auto& beatmapAD = GetBeatmapAD();
+  for (auto const& event : events) {
+    TracksAD::LoadTrackEvent(event.get(), beatmapAD, beatmapData.v2orEarlier);
+  }
+}
+
+void SessionReplay::RunFrame(size_t index) {
+  auto const& frame = session.frames[index];
+  auto& beatmapAD = GetBeatmapAD();
+
+  auto coroutineManager = beatmapAD.GetCoroutineManager();
+  auto baseManager = beatmapAD.GetBaseProviderContext();
+  auto tracksHolder = beatmapAD.GetTracksHolder();
+
+  for (auto const& change : frame.baseValues) {
+    baseManager->SetBaseValue(session.baseKeys[change.key], change.value);
+  }
+
+  for (auto const& fired : frame.firedEvents) {
+    auto const& eventAD = TracksAD::getEventAD(events[fired.event].get());
+    for (auto const& eventData : eventAD.rustEventData) {
+      coroutineManager->StartCoroutine(fired.bpm, fired.songTime, *baseManager, *tracksHolder, *eventData);
+    }
+  }
+
+  coroutineManager->PollCoroutines(frame.songTime, *baseManager, *tracksHolder);
+}
+
+void SessionReplay::Run() {
+  for (size_t i = 0; i < session.frames.size(); i++) {
+    RunFrame(i);
+  }
+}
+
+} // namespace TracksBench
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "AssociatedData.h"
+#include "SessionRecording.h"
+
+namespace TracksBench {
+
+/// Headless replay of a recorded session: rebuilds the beatmap and its events from the recorded JSON,
+/// then feeds every frame through CoroutineManagerW::StartCoroutine/PollCoroutines.
+class SessionReplay {
+public:
+  explicit SessionReplay(Tracks::SessionRecording::Session session);
+  SessionReplay(SessionReplay const&) = delete;
+
+  /// Fresh beatmap associated data with all recorded events loaded, i.e. the state before the first frame
+  void Reset();
+
+  void RunFrame(size_t index);
+  void Run();
+
+  [[nodiscard]] size_t FrameCount() const {
+    return session.frames.size();
+  }
+  [[nodiscard]] size_t EventCount() const {
+    return session.events.size();
+  }
+
+  TracksAD::BeatmapAssociatedData& GetBeatmapAD() {
+    return TracksAD::getBeatmapAD(&beatmapCustomData);
+  }
+
+private:
+  Tracks::SessionRecording::Session session;
+
+  rapidjson::Document beatmapDocument;
+  std::vector<std::unique_ptr<rapidjson::Document>> eventDocuments;
+
+  CustomJSONData::CustomBeatmapData beatmapData;
+  CustomJSONData::JSONWrapper beatmapCustomData;
+  std::vector<std::unique_ptr<CustomJSONData::CustomEventData>> events;
+};
+
+} // namespace TracksBench
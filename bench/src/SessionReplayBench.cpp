@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <optional>
+
+#include "BenchCommon.hpp"
+#include "SessionReplay.hpp"
+
+using namespace TracksBench;
+
+// Replays a session recorded on device (TRACKS_SESSION_RECORDING) from the file in the TRACKS_SESSION environment
+// variable. One iteration is the whole session, loading is not timed.
+
+static void BM_SessionReplay(benchmark::State& state) {
+  char const* path = std::getenv("TRACKS_SESSION");
+  if (!path) {
+    state.SkipWithError("TRACKS_SESSION is not set");
+    return;
+  }
+
+  std::optional<SessionReplay> replay;
+  try {
+    replay.emplace(Tracks::SessionRecording::ReadSession(path));
+  } catch (std::exception const& e) {
+    state.SkipWithError(e.what());
+    return;
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    replay->Reset();
+    ResetFfiCounters();
+    state.ResumeTiming();
+
+    replay->Run();
+  }
+  ReportFfiCounters(state, double(replay->FrameCount()));
+
+  state.SetLabel(path);
+  state.counters["frames"] = double(replay->FrameCount());
+  state.counters["events"] = double(replay->EventCount());
+  state.counters["frame_time"] = benchmark::Counter(double(state.iterations() * replay->FrameCount()),
+                                                    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_SessionReplay)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,167 @@
+#include "SyntheticMap.hpp"
+
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "AssociatedData.h"
+#include "BenchCommon.hpp"
+
+namespace TracksBench {
+
+namespace {
+
+constexpr std::string_view animateTrackType = "AnimateTrack";
+constexpr std::string_view assignPathAnimationType = "AssignPathAnimation";
+
+/// Key names for the map version, v2 prefixes everything with an underscore
+struct Keys {
+  char const* track;
+  char const* duration;
+  char const* easing;
+  char const* position;
+  char const* localRotation;
+  char const* scale;
+  char const* dissolve;
+  char const* definitePosition;
+};
+
+constexpr Keys v3Keys = { "track",    "duration", "easing",   "position",
+                          "localRotation", "scale", "dissolve", "definitePosition" };
+constexpr Keys v2Keys = { "_track",   "_duration", "_easing",   "_position",
+                          "_localRotation", "_scale", "_dissolve", "_definitePosition" };
+
+std::string TrackName(int index) {
+  return fmt::format("track{}", index);
+}
+
+std::string PointDefinitionName(int index) {
+  return fmt::format("pointDefinition{}", index);
+}
+
+std::string TracksJson(std::mt19937& rng, SyntheticMapSpec const& spec, int count) {
+  std::uniform_int_distribution<int> trackDist(0, spec.tracks - 1);
+  if (count == 1) {
+    return fmt::format("\"{}\"", TrackName(trackDist(rng)));
+  }
+
+  std::string json = "[";
+  for (int i = 0; i < count; i++) {
+    json += fmt::format("{}\"{}\"", i == 0 ? "" : ",", TrackName(trackDist(rng)));
+  }
+  return json + "]";
+}
+
+} // namespace
+
+SyntheticMap::SyntheticMap(SyntheticMapSpec const& spec) : spec(spec) {
+  std::mt19937 rng(spec.seed);
+  auto const& keys = spec.v2 ? v2Keys : v3Keys;
+
+  std::uniform_int_distribution<int> tracksPerNoteDist(1, std::max(1, spec.maxTracksPerNote));
+  std::uniform_int_distribution<int> percentDist(0, 99);
+  std::uniform_int_distribution<int> easingDist(Functions::EaseLinear, Functions::EaseInOutBounce);
+  std::uniform_int_distribution<int> pointDefinitionDist(0, std::max(0, spec.pointDefinitions - 1));
+
+  std::string json;
+  json.reserve(size_t(spec.notes) * 48 + size_t(spec.events) * 160 +
+               size_t(spec.pointDefinitions) * size_t(spec.pointsPerDefinition) * 32);
+
+  // beatmap custom data with the named point definitions
+  json += "{\"customData\":{";
+  json += spec.v2 ? "\"_pointDefinitions\":[" : "\"pointDefinitions\":{";
+  for (int i = 0; i < spec.pointDefinitions; i++) {
+    PointsSpec pointsSpec{ .count = spec.pointsPerDefinition,
+                           .type = Tracks::ffi::WrapBaseValueType::Vec3,
+                           .easing = static_cast<Functions>(easingDist(rng)),
+                           .spline = percentDist(rng) < 10 };
+    auto points = MakePointsJson(pointsSpec);
+
+    if (i != 0) json += ",";
+    if (spec.v2) {
+      json += fmt::format("{{\"_name\":\"{}\",\"_points\":{}}}", PointDefinitionName(i), points);
+    } else {
+      json += fmt::format("\"{}\":{}", PointDefinitionName(i), points);
+    }
+  }
+  json += spec.v2 ? "]}" : "}}";
+
+  // note custom data
+  json += ",\"notes\":[";
+  for (int i = 0; i < spec.notes; i++) {
+    json += fmt::format("{}{{\"{}\":{}}}", i == 0 ? "" : ",", keys.track,
+                        TracksJson(rng, spec, tracksPerNoteDist(rng)));
+  }
+  json += "]";
+
+  // event data, position references named definitions, the rest is inline like most maps
+  json += ",\"events\":[";
+  for (int i = 0; i < spec.events; i++) {
+    int trackCount = percentDist(rng) < spec.multiTrackEventPercent ? tracksPerNoteDist(rng) + 1 : 1;
+    auto position = spec.pointDefinitions > 0
+                        ? fmt::format("\"{}\"", PointDefinitionName(pointDefinitionDist(rng)))
+                        : MakePointsJson({ .count = spec.pointsPerDefinition });
+    auto rotation = MakePointsJson({ .count = 4, .type = Tracks::ffi::WrapBaseValueType::Quat });
+    auto dissolve = MakePointsJson({ .count = 2, .type = Tracks::ffi::WrapBaseValueType::Float });
+
+    json += fmt::format("{}{{\"{}\":{},\"{}\":{},\"{}\":\"{}\"", i == 0 ? "" : ",", keys.track,
+                        TracksJson(rng, spec, trackCount), keys.duration, 1 + i % 16, keys.easing,
+                        EasingName(static_cast<Functions>(easingDist(rng))));
+    if (i % 2 == 0) {
+      json += fmt::format(",\"{}\":{},\"{}\":{},\"{}\":{}}}", keys.position, position, keys.localRotation, rotation,
+                          keys.dissolve, dissolve);
+    } else {
+      json += fmt::format(",\"{}\":{},\"{}\":{}}}", keys.definitePosition, position, keys.scale,
+                          MakePointsJson({ .count = 3 }));
+    }
+  }
+  json += "]}";
+
+  document.Parse(json.c_str());
+  CRASH_UNLESS(!document.HasParseError());
+
+  beatmapData.v2orEarlier = spec.v2;
+  beatmapCustomData.value = document["customData"];
+  beatmapData.customData = &beatmapCustomData;
+
+  auto const& notesJson = document["notes"];
+  noteCustomDatas.reserve(notesJson.Size());
+  notes.reserve(notesJson.Size());
+  for (rapidjson::SizeType i = 0; i < notesJson.Size(); i++) {
+    auto& wrapper = noteCustomDatas.emplace_back(std::make_unique<CustomJSONData::JSONWrapper>());
+    wrapper->value = notesJson[i];
+
+    auto& note = notes.emplace_back(std::make_unique<CustomJSONData::CustomNoteData>());
+    note->time = float(i) / 8.0f;
+    note->customData = wrapper.get();
+    beatmapData.beatmapObjectDatas.push_back(note.get());
+  }
+
+  auto const& eventsJson = document["events"];
+  events.reserve(eventsJson.Size());
+  for (rapidjson::SizeType i = 0; i < eventsJson.Size(); i++) {
+    auto& event = events.emplace_back(std::make_unique<CustomJSONData::CustomEventData>());
+    event->time = float(i) / 4.0f;
+    event->type = i % 2 == 0 ? animateTrackType : assignPathAnimationType;
+    event->typeHash = std::hash<std::string_view>()(event->type);
+    event->data = &eventsJson[i];
+    eventPtrs.push_back(event.get());
+  }
+  SetEventsAttached(true);
+}
+
+void SyntheticMap::Reset() {
+  beatmapCustomData.associatedData.clear();
+  for (auto& wrapper : noteCustomDatas) {
+    wrapper->associatedData.clear();
+  }
+  TracksAD::clearEventADs();
+}
+
+void SyntheticMap::SetEventsAttached(bool attached) {
+  beatmapData.customEventDatas = attached ? eventPtrs : std::vector<CustomJSONData::CustomEventData*>();
+}
+
+} // namespace TracksBench
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+#include "custom-json-data/shared/CustomBeatmapData.h"
+
+namespace TracksBench {
+
+/// Size and shape of a generated modchart, defaults are a heavy but realistic v3 map
+struct SyntheticMapSpec {
+  int notes = 100000;
+  int tracks = 2000;
+  // notes get 1..maxTracksPerNote tracks, a single track is written as a string like maps do
+  int maxTracksPerNote = 3;
+  int events = 20000;
+  int pointDefinitions = 4000;
+  int pointsPerDefinition = 8;
+  // events spanning several tracks, out of 100
+  int multiTrackEventPercent = 20;
+  bool v2 = false;
+  uint32_t seed = 1337;
+};
+
+/// Deterministic CustomBeatmapData-shaped input for readBeatmapDataAD and LoadTrackEvent.
+/// Owns the JSON document and every CJD object pointing into it.
+class SyntheticMap {
+public:
+  explicit SyntheticMap(SyntheticMapSpec const& spec);
+  SyntheticMap(SyntheticMap const&) = delete;
+
+  /// Drops all associated data so the map can be read again
+  void Reset();
+
+  /// Leaves customEventDatas empty on the beatmap so readBeatmapDataAD stops after the object pass
+  void SetEventsAttached(bool attached);
+
+  CustomJSONData::CustomBeatmapData* GetBeatmapData() {
+    return &beatmapData;
+  }
+
+  std::vector<CustomJSONData::CustomEventData*> const& GetEvents() const {
+    return eventPtrs;
+  }
+
+  SyntheticMapSpec const spec;
+
+private:
+  rapidjson::Document document;
+
+  CustomJSONData::CustomBeatmapData beatmapData;
+  CustomJSONData::JSONWrapper beatmapCustomData;
+  std::vector<std::unique_ptr<CustomJSONData::JSONWrapper>> noteCustomDatas;
+  std::vector<std::unique_ptr<CustomJSONData::CustomNoteData>> notes;
+  std::vector<std::unique_ptr<CustomJSONData::CustomEventData>> events;
+  std::vector<CustomJSONData::CustomEventData*> eventPtrs;
+};
+
+} // namespace TracksBench
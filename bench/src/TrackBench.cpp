@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <optional>
+#include <vector>
+
+#include "BenchCommon.hpp"
+
+#include "Animation/Animation.h"
+#include "Animation/Easings.h"
+#include "Animation/Track.h"
+
+using namespace TracksBench;
+using Tracks::ffi::WrapBaseValueType;
+
+// Host build smoke benchmarks: the smallest hot-path pieces that every other suite builds on.
+
+static void BM_TrackGetPropertyNamed(benchmark::State& state) {
+  BeatmapFixture fixture;
+  auto track = fixture.AddTrack("track");
+
+  for (auto _ : state) {
+    auto value = track.GetPropertyNamed(PropertyNames::Position).GetValue();
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_TrackGetPropertyNamed);
+
+static void BM_TrackGetPropertyString(benchmark::State& state) {
+  BeatmapFixture fixture;
+  auto track = fixture.AddTrack("track");
+
+  for (auto _ : state) {
+    auto value = track.GetProperty("position").GetValue();
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_TrackGetPropertyString);
+
+static void BM_TrackGetPropertyHandle(benchmark::State& state) {
+  BeatmapFixture fixture;
+  auto track = fixture.AddTrack("track");
+  auto handle = PropertyHandle::Resolve("position");
+
+  for (auto _ : state) {
+    auto value = track.GetProperty(handle).GetValue();
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK(BM_TrackGetPropertyHandle);
+
+static void BM_TrackGetTrackKey(benchmark::State& state) {
+  BeatmapFixture fixture;
+  for (int i = 0; i < state.range(0); i++) {
+    fixture.AddTrack("track" + std::to_string(i));
+  }
+
+  auto holder = fixture.beatmapAD.GetTracksHolder();
+  for (auto _ : state) {
+    auto key = holder->GetTrackKey("track0");
+    benchmark::DoNotOptimize(key);
+  }
+}
+BENCHMARK(BM_TrackGetTrackKey)->Range(1, 4096);
+
+static void BM_Easings(benchmark::State& state) {
+  auto function = static_cast<Functions>(state.range(0));
+  float t = 0;
+
+  for (auto _ : state) {
+    t += 1.0f / 1024.0f;
+    if (t > 1) t = 0;
+    benchmark::DoNotOptimize(Easings::Interpolate(t, function));
+  }
+}
+BENCHMARK(BM_Easings)->DenseRange(Functions::EaseLinear, Functions::EaseInOutBounce);
+
+// Animation::multiplyPropertiesVec3 and addPropertiesVec3 over two tracks. Fails unless scales come out as the
+// product and positions as the sum of the track values, products used to start from a zero vector
+static void BM_FoldProperties(benchmark::State& state) {
+  BeatmapFixture fixture;
+  std::vector<TrackW> tracks = { fixture.AddTrack("a"), fixture.AddTrack("b") };
+  fixture.Set(tracks[0], PropertyNames::Scale, WrapBaseValueType::Vec3, "[[2, 3, 4, 0]]");
+  fixture.Set(tracks[1], PropertyNames::Scale, WrapBaseValueType::Vec3, "[[0.5, 2, 1, 0]]");
+  fixture.Set(tracks[0], PropertyNames::Position, WrapBaseValueType::Vec3, "[[1, 2, 3, 0]]");
+  fixture.Set(tracks[1], PropertyNames::Position, WrapBaseValueType::Vec3, "[[4, 5, 6, 0]]");
+  fixture.PollCoroutines(1);
+
+  std::optional<NEVector::Vector3> scale;
+  std::optional<NEVector::Vector3> position;
+  for (auto _ : state) {
+    scale = Animation::multiplyPropertiesVec3(tracks, PropertyNames::Scale, TimeUnit());
+    position = Animation::addPropertiesVec3(tracks, PropertyNames::Position, TimeUnit());
+    benchmark::DoNotOptimize(scale);
+    benchmark::DoNotOptimize(position);
+  }
+
+  auto equals = [](std::optional<NEVector::Vector3> const& value, NEVector::Vector3 expected) {
+    return value && value->x == expected.x && value->y == expected.y && value->z == expected.z;
+  };
+  if (!equals(scale, { 1, 6, 4 }) || !equals(position, { 5, 7, 9 })) {
+    state.SkipWithError("folded track values changed");
+  }
+}
+BENCHMARK(BM_FoldProperties);
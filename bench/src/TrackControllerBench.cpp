@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "BenchCommon.hpp"
+
+#include "Animation/GameObjectTrackController.hpp"
+#include "Animation/GameObjectTrackSystem.hpp"
+#include "beatsaber-hook/shared/utils/logging.hpp"
+
+using namespace TracksBench;
+using Tracks::ffi::WrapBaseValueType;
+
+// GameObjectTrackSystem::UpdateAll for N controllers x M tracks each.
+// Tracks are animated by long running AnimateTrack events so their properties change every frame, coroutines are
+// polled outside the timed region. Transform writes are counted by the Transform shim instead of going to Unity.
+
+namespace {
+
+constexpr float frameTime = 1.0f / 90.0f;
+constexpr int trackPoolSize = 64;
+
+struct ControllerFixture : BeatmapFixture {
+  std::vector<TrackW> tracks;
+
+  std::vector<std::unique_ptr<UnityEngine::GameObject>> gameObjects;
+  std::vector<Tracks::GameObjectTrackController*> controllers;
+
+  float songTime = 0;
+
+  // animatedPercent of the track pool is animated, the rest stays idle. Controllers draw from a pool of
+  // trackPoolSize tracks, so they end up sharing a few composites, or each get their own tracks if uniqueTracks
+  ControllerFixture(int controllerCount, int tracksPerController, int animatedPercent = 100,
+                    bool uniqueTracks = false) {
+    int poolSize = uniqueTracks ? controllerCount * tracksPerController : std::max(trackPoolSize, tracksPerController);
+    for (int i = 0; i < poolSize; i++) {
+      tracks.push_back(AddTrack("track" + std::to_string(i)));
+    }
+
+    auto vec3 = MakePointDefinition({ .count = 8, .type = WrapBaseValueType::Vec3 }, beatmapAD.GetBaseProviderContext());
+    auto quat = MakePointDefinition({ .count = 8, .type = WrapBaseValueType::Quat }, beatmapAD.GetBaseProviderContext());
+    pointDefinitions = { vec3, quat };
+
+    auto animatedCount = (tracks.size() * animatedPercent + 99) / 100;
+    for (auto const& track : std::span(tracks).first(animatedCount)) {
+      Animate(track, PropertyNames::Position, vec3, 1e6f, songTime);
+      Animate(track, PropertyNames::LocalPosition, vec3, 1e6f, songTime);
+      Animate(track, PropertyNames::Scale, vec3, 1e6f, songTime);
+      Animate(track, PropertyNames::Rotation, quat, 1e6f, songTime);
+      Animate(track, PropertyNames::LocalRotation, quat, 1e6f, songTime);
+    }
+
+    // OnTransformParentChanged logs every controller at error level
+    Paper::hostLogThreshold = Paper::LogLevel::OFF;
+    for (int i = 0; i < controllerCount; i++) {
+      auto& gameObject = gameObjects.emplace_back(std::make_unique<UnityEngine::GameObject>("controller"));
+
+      std::vector<TrackW> controllerTracks;
+      for (int j = 0; j < tracksPerController; j++) {
+        controllerTracks.push_back(tracks[(i * tracksPerController + j) % poolSize]);
+      }
+
+      auto controller =
+          Tracks::GameObjectTrackController::HandleTrackData(gameObject.get(), controllerTracks, 0.6f, false, false);
+      CRASH_UNLESS(controller);
+      (*controller)->Awake();
+      (*controller)->OnEnable();
+      (*controller)->Start();
+      controllers.push_back(*controller);
+    }
+    Paper::hostLogThreshold = Paper::LogLevel::ERR;
+  }
+
+  ~ControllerFixture() {
+    // what Unity does when the objects go away, leaves the system empty for the next benchmark
+    for (auto* controller : controllers) {
+      controller->OnDisable();
+      controller->OnDestroy();
+    }
+  }
+
+  void Poll() {
+    songTime += frameTime;
+    PollCoroutines(songTime);
+  }
+};
+
+void RunFrames(benchmark::State& state, ControllerFixture& fixture) {
+  auto writesBefore = UnityEngine::Transform::writes.total();
+  ResetFfiCounters();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    fixture.Poll();
+    state.ResumeTiming();
+
+    Tracks::GameObjectTrackSystem::UpdateAll();
+  }
+
+  auto frames = double(state.iterations());
+  auto controllerUpdates = frames * double(fixture.controllers.size());
+  state.counters["controllers"] = double(fixture.controllers.size());
+  state.counters["composites"] = double(Tracks::GameObjectTrackSystem::CompositeCount());
+  state.counters["writes/frame"] = double(UnityEngine::Transform::writes.total() - writesBefore) / frames;
+  // time per controller, i.e. where the per object cost stops being flat
+  state.counters["per_controller"] =
+      benchmark::Counter(controllerUpdates, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+  // includes the untimed coroutine polling
+  ReportFfiCounters(state, frames);
+}
+
+} // namespace
+
+// single track path, controllers share the 64 tracks of the pool. args: controller count
+static void BM_UpdateDataSingleTrack(benchmark::State& state) {
+  ControllerFixture fixture(int(state.range(0)), 1);
+  RunFrames(state, fixture);
+}
+BENCHMARK(BM_UpdateDataSingleTrack)
+    ->ArgNames({ "controllers" })
+    ->RangeMultiplier(4)
+    ->Range(1, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+// multi track path, folded once per distinct track list (composite) and frame,
+// args: controller count, tracks per controller
+static void BM_UpdateDataMultiTrack(benchmark::State& state) {
+  ControllerFixture fixture(int(state.range(0)), int(state.range(1)));
+  RunFrames(state, fixture);
+}
+BENCHMARK(BM_UpdateDataMultiTrack)
+    ->ArgNames({ "controllers", "tracks" })
+    ->ArgsProduct({ benchmark::CreateRange(1, 16384, 4), { 2, 4, 16 } })
+    ->Unit(benchmark::kMicrosecond);
+
+// environment style maps where most tracks are idle, idle controllers should stop at the transform generation check.
+// args: controller count, percentage of animated tracks
+static void BM_UpdateDataIdleTracks(benchmark::State& state) {
+  ControllerFixture fixture(int(state.range(0)), 1, int(state.range(1)));
+  RunFrames(state, fixture);
+}
+BENCHMARK(BM_UpdateDataIdleTracks)
+    ->ArgNames({ "controllers", "animated%" })
+    ->ArgsProduct({ { 1024, 16384 }, { 0, 10, 100 } })
+    ->Unit(benchmark::kMicrosecond);
+
+// no sharing, every controller has its own track list and so its own composite, the per object cost without
+// deduplication. args: controller count, tracks per controller
+static void BM_UpdateDataUniqueTracks(benchmark::State& state) {
+  ControllerFixture fixture(int(state.range(0)), int(state.range(1)), 100, true);
+  RunFrames(state, fixture);
+}
+BENCHMARK(BM_UpdateDataUniqueTracks)
+    ->ArgNames({ "controllers", "tracks" })
+    ->ArgsProduct({ benchmark::CreateRange(1, 4096, 4), { 1, 4 } })
+    ->Unit(benchmark::kMicrosecond);
+
+// two controllers on one track, the second one misses a version of the composite while the first is updated twice.
+// Fails unless the second catches up with every value, not just the ones of the latest combine
+static void BM_UpdateDataMissedVersion(benchmark::State& state) {
+  ControllerFixture fixture(2, 1, 0);
+  auto shared = fixture.controllers[0]->getTrackControllerData()._track;
+  fixture.controllers[1]->getTrackControllerData().SetTracks(shared, false);
+  auto const& track = shared.front();
+
+  fixture.Set(track, PropertyNames::Position, WrapBaseValueType::Vec3, "[[1, 2, 3, 0]]");
+  fixture.Poll();
+  Tracks::GameObjectTrackSystem::UpdateAll();
+
+  fixture.Set(track, PropertyNames::Position, WrapBaseValueType::Vec3, "[[4, 5, 6, 0]]");
+  fixture.Poll();
+  fixture.controllers[0]->UpdateData(false);
+  fixture.Set(track, PropertyNames::Scale, WrapBaseValueType::Vec3, "[[2, 2, 2, 0]]");
+  fixture.Poll();
+  fixture.controllers[0]->UpdateData(false);
+  fixture.controllers[1]->UpdateData(false);
+
+  for (auto _ : state) {
+    Tracks::GameObjectTrackSystem::UpdateAll();
+  }
+
+  auto* transform = fixture.controllers[1]->get_transform();
+  if (transform->position.x != 4 || transform->position.z != 6 || transform->localScale.x != 2) {
+    state.SkipWithError("missed composite version was not caught up");
+  }
+  state.counters["composites"] = double(Tracks::GameObjectTrackSystem::CompositeCount());
+}
+BENCHMARK(BM_UpdateDataMissedVersion);
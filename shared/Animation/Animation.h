@@ -15,6 +15,17 @@
     }                                                                                                                  \
   }
 
+// Streaming counterpart of TRACKS_LIST_OPERATE_MULTIPLE, the first value starts the fold.
+// A single statement, safe inside an unbraced if/else
+#define TRACKS_FOLD_OPERATE(target, value, op)                                                                         \
+  do {                                                                                                                 \
+    if (target) {                                                                                                      \
+      target = *target op(value);                                                                                      \
+    } else {                                                                                                           \
+      target = (value);                                                                                                \
+    }                                                                                                                  \
+  } while (0)
+
 namespace GlobalNamespace {
 class BeatmapData;
 }
@@ -25,11 +36,6 @@ struct BeatmapAssociatedData;
 
 namespace Animation {
 
-[[nodiscard]]
-static auto getCurrentTime() {
-  return Tracks::ffi::get_time();
-}
-
 /**
  * @brief Parse point definition from custom data. 3 possible cases:
  * 1. Point definition is a string, look up in beatmap associated data
@@ -43,10 +49,12 @@ static auto getCurrentTime() {
  * "pointDef"}`
  * @param customDataKey the key to look for in customData
  * @param type The type of the point definition e.g float, vec3, quat or vec4
+ * @param bake Bake the definition into a lookup table where possible, see PointDefinitionW::Bake
  * @return PointDefinitionW
  */
 PointDefinitionW ParsePointData(TracksAD::BeatmapAssociatedData& beatmapAD, rapidjson::Value const& customData,
-                                std::string_view customDataKey, Tracks::ffi::WrapBaseValueType type);
+                                std::string_view customDataKey, Tracks::ffi::WrapBaseValueType type,
+                                BakedPointDefinition::Options const* bake = nullptr);
 
 #pragma region track_utils
 
@@ -165,6 +173,42 @@ GENERATE_PROPERTY_GETTERS(NEVector::Vector4, Vec4, ToVector4)
 GENERATE_PROPERTY_GETTERS(NEVector::Quaternion, Quat, ToQuaternion)
 GENERATE_PROPERTY_GETTERS(float, Float, ToFloat)
 
+// Macro to generate getters that fold the values of all tracks in place instead of collecting them
+#define GENERATE_PROPERTY_FOLDS(ReturnType, Suffix, Conversion, FoldName, op)                                          \
+  [[nodiscard]]                                                                                                        \
+  inline std::optional<ReturnType> FoldName##Properties##Suffix(std::span<TrackW const> tracks, PropertyNames name,    \
+                                                                TimeUnit time) {                                       \
+    std::optional<ReturnType> result;                                                                                  \
+    for (auto const& track : tracks) {                                                                                 \
+      auto value = track.GetPropertyNamed(name).GetValue();                                                            \
+      if (!value.value.has_value) continue;                                                                            \
+      if (TimeUnit(value.last_updated) <= time) continue;                                                              \
+      TRACKS_FOLD_OPERATE(result, Conversion(value.value.value), op);                                                  \
+    }                                                                                                                  \
+    return result;                                                                                                     \
+  }                                                                                                                    \
+                                                                                                                       \
+  [[nodiscard]]                                                                                                        \
+  inline std::optional<ReturnType> FoldName##PathProperties##Suffix(std::span<TrackW const> tracks,                    \
+                                                                    PropertyNames name, float time) {                  \
+    std::optional<ReturnType> result;                                                                                  \
+    for (auto const& track : tracks) {                                                                                 \
+      auto value = track.GetPathPropertyNamed(name).Interpolate(time);                                                 \
+      if (!value.has_value()) continue;                                                                                \
+      TRACKS_FOLD_OPERATE(result, Conversion(*value), op);                                                             \
+    }                                                                                                                  \
+    return result;                                                                                                     \
+  }
+
+// sums for positions, products for rotations and scales
+GENERATE_PROPERTY_FOLDS(NEVector::Vector3, Vec3, ToVector3, add, +)
+GENERATE_PROPERTY_FOLDS(NEVector::Vector4, Vec4, ToVector4, add, +)
+GENERATE_PROPERTY_FOLDS(float, Float, ToFloat, add, +)
+GENERATE_PROPERTY_FOLDS(NEVector::Vector3, Vec3, ToVector3, multiply, *)
+GENERATE_PROPERTY_FOLDS(NEVector::Vector4, Vec4, ToVector4, multiply, *)
+GENERATE_PROPERTY_FOLDS(NEVector::Quaternion, Quat, ToQuaternion, multiply, *)
+GENERATE_PROPERTY_FOLDS(float, Float, ToFloat, multiply, *)
+
 // Macro to generate addition functions for spans
 #define GENERATE_ADD_FUNCTIONS(Type, TypeName)                                                                         \
   [[nodiscard]]                                                                                                        \
@@ -14,26 +14,45 @@
 #include "custom-types/shared/macros.hpp"
 
 namespace Tracks {
+class GameObjectTrackController;
+
+/**
+ * @brief Track list of a GameObjectTrackController.
+ *
+ * GameObjectTrackSystem reads _track and v2 when the controller is refreshed, not every frame. Change them through
+ * SetTracks, or call GameObjectTrackSystem::Refresh after writing the fields directly, otherwise the controller keeps
+ * following the old list.
+ */
 struct GameObjectTrackControllerData {
   GameObjectTrackControllerData() = delete;
   GameObjectTrackControllerData(GameObjectTrackControllerData const&) = delete;
   GameObjectTrackControllerData(std::span<TrackW const> track, bool v2) : _track(track.begin(), track.end()), v2(v2) {}
 
+  /// Replaces the track list and v2 flag and refreshes the owning controller
+  void SetTracks(std::span<TrackW const> track, bool v2);
+
   std::vector<TrackW> _track;
   bool v2;
+  // set by HandleTrackData
+  GameObjectTrackController* owner = nullptr;
 
   UnorderedEventCallback<> PositionUpdate;
   UnorderedEventCallback<> ScaleUpdate;
   UnorderedEventCallback<> RotationUpdate;
 };
+
+class GameObjectTrackSystem;
 } // namespace Tracks
 
 DECLARE_CLASS_CODEGEN(Tracks, GameObjectTrackController, UnityEngine::MonoBehaviour) {
   DECLARE_INSTANCE_FIELD(UnityEngine::Transform*, parent);
   DECLARE_INSTANCE_FIELD(UnityEngine::Transform*, origin);
   GameObjectTrackControllerData* data;
-  TimeUnit lastCheckedTime;
   int attemptedTries;
+  // position in GameObjectTrackSystem while enabled
+  size_t systemIndex;
+
+  friend class Tracks::GameObjectTrackSystem;
 
 public:
   static bool LeftHanded;
@@ -44,13 +63,16 @@ public:
 
   static void ClearData();
 
+  /// Updated by GameObjectTrackSystem every frame, call with force to apply the current values right away
   void UpdateData(bool force);
+  /// Counts the tries while data is missing and eventually destroys the component
+  void HandleMissingTracks();
   GameObjectTrackControllerData& getTrackControllerData();
   DECLARE_INSTANCE_METHOD(void, Awake);
   DECLARE_INSTANCE_METHOD(void, Start);
   DECLARE_INSTANCE_METHOD(void, OnDestroy);
   DECLARE_INSTANCE_METHOD(void, OnEnable);
-  DECLARE_INSTANCE_METHOD(void, Update);
+  DECLARE_INSTANCE_METHOD(void, OnDisable);
   DECLARE_INSTANCE_METHOD(void, OnTransformParentChanged);
 
   DECLARE_SIMPLE_DTOR();
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Track.h"
+#include "TransformWriter.hpp"
+
+namespace UnityEngine {
+class Transform;
+}
+
+namespace Tracks {
+class GameObjectTrackController;
+
+/// Combined transform values of a track list, empty where no track changed since the last check
+struct CompositeTransform {
+  std::optional<NEVector::Vector3> position;
+  std::optional<NEVector::Vector3> localPosition;
+  std::optional<NEVector::Quaternion> rotation;
+  std::optional<NEVector::Quaternion> localRotation;
+  std::optional<NEVector::Vector3> scale;
+
+  /// Values written after lastCheckedEpoch, everything for 0. Multiple tracks are folded, sums for positions and
+  /// products for rotations and scales. Everything is read with one FFI call per track, changes since an epoch go
+  /// through the stamped GetTransformSnapshot
+  static CompositeTransform Combine(std::span<TrackW const> tracks, uint64_t lastCheckedEpoch);
+};
+
+/**
+ * @brief Track list shared by controllers, combined at most once per TracksHolderW::writeEpoch.
+ *
+ * Keyed by the ordered list of track keys, rotations are multiplied in list order so ["a", "b"] and ["b", "a"] are
+ * different composites. Every controller with the same list reads the same result.
+ */
+struct CompositeTrack {
+  std::vector<TrackW> tracks;
+  uint32_t users = 0;
+
+  // TracksHolderW::writeEpoch of the last combine
+  uint64_t lastCheckedEpoch = 0;
+  // sum of the transform generations of the tracks at the last combine
+  uint64_t lastTransformGeneration = 0;
+  // TracksHolderW::writeEpoch of the last evaluation, nothing was written while it still matches
+  uint64_t evaluatedEpoch = 0;
+  // bumped whenever result was combined again
+  uint64_t version = 0;
+  CompositeTransform result;
+};
+
+/**
+ * @brief Updates every enabled GameObjectTrackController in one loop, once per frame.
+ *
+ * Controllers register themselves in OnEnable and leave in OnDisable/OnDestroy, the hot state of each one is kept
+ * in parallel arrays indexed by GameObjectTrackController::systemIndex and removed by swapping with the last entry.
+ *
+ * Unity never calls into the controllers per frame. For custom beatmaps UpdateAll runs in Events::UpdateCoroutines
+ * right after the coroutines are polled, a coroutine step after every Update of the frame rather than during it.
+ * Other beatmaps tick it from BeatmapCallbacksController::ManualUpdate, i.e. during Update. Nothing ticks it
+ * outside of a song, UpdateData(true) applies the current values on demand there.
+ */
+class GameObjectTrackSystem {
+public:
+  static constexpr size_t unregistered = static_cast<size_t>(-1);
+
+  static void Register(GameObjectTrackController* controller);
+  static void Unregister(GameObjectTrackController* controller);
+  /// Picks up a new origin, track list or v2 flag of a registered controller and forces its next update
+  static void Refresh(GameObjectTrackController* controller);
+
+  static void Update(size_t index, bool force);
+  static void UpdateAll();
+
+  /// Forgets every controller and drops the composites with their holder references, their indices are reset too.
+  /// Called once the song is over
+  static void Clear();
+  static size_t Count();
+  /// Distinct track lists in use
+  static size_t CompositeCount();
+
+private:
+  static bool IsRegistered(GameObjectTrackController const* controller);
+
+  static uint32_t AcquireComposite(std::span<TrackW const> trackList);
+  static void ReleaseComposite(uint32_t composite);
+  static CompositeTrack& EvaluateComposite(uint32_t composite);
+  static void Apply(size_t index, CompositeTransform values, bool force);
+
+  static constexpr uint32_t noComposite = static_cast<uint32_t>(-1);
+
+  struct KeyListHash {
+    size_t operator()(std::vector<uint64_t> const& keys) const noexcept;
+  };
+
+  // parallel, one entry per registered controller
+  static std::vector<GameObjectTrackController*> controllers;
+  static std::vector<UnityEngine::Transform*> origins;
+  static std::vector<uint8_t> v2;
+  static std::vector<uint32_t> compositeIndices;
+  // CompositeTrack::version last applied to the transform
+  static std::vector<uint64_t> appliedVersions;
+
+  // released slots are reused through freeComposites
+  static std::vector<CompositeTrack> composites;
+  static std::vector<uint32_t> freeComposites;
+  static std::unordered_map<std::vector<uint64_t>, uint32_t, KeyListHash> compositeLookup;
+};
+} // namespace Tracks
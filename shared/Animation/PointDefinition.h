@@ -1,8 +1,14 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "../Vector.h"
 #include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
@@ -11,22 +17,249 @@
 #include "UnityEngine/Color.hpp"
 #include "beatsaber-hook/shared/rapidjson/include/rapidjson/document.h"
 #include "../bindings.h"
+#include "../FfiAccounting.h"
 #include "../binding_wrappers.hpp"
 
+/**
+ * @brief A rapidjson value converted for tracks_rs, the whole tree lives in one allocation.
+ *
+ * Freed with the object, so only keep Root() for as long as the call it is passed to.
+ * Strings point into the rapidjson document.
+ */
+class ConvertedJson {
+public:
+  explicit ConvertedJson(rapidjson::Value const& value);
+  ConvertedJson(ConvertedJson const&) = delete;
+  ConvertedJson(ConvertedJson&&) noexcept = default;
+
+  [[nodiscard]] Tracks::ffi::FFIJsonValue const* Root() const {
+    return reinterpret_cast<Tracks::ffi::FFIJsonValue const*>(storage.get());
+  }
+  [[nodiscard]] size_t Nodes() const {
+    return nodes;
+  }
+  [[nodiscard]] size_t Bytes() const {
+    return bytes;
+  }
+
+  /// Gives up ownership, the tree is never freed
+  Tracks::ffi::FFIJsonValue const* Release();
+
+private:
+  std::unique_ptr<std::byte[]> storage;
+  size_t nodes = 0;
+  size_t bytes = 0;
+};
+
+/**
+ * @brief Scratch memory for converting rapidjson values for tracks_rs in a single pass.
+ *
+ * Blocks are kept across conversions, so once warmed up building a point definition does not allocate on the
+ * C++ side at all. A converted tree is only valid until the next Convert or Reset.
+ */
+class JsonArena {
+public:
+  JsonArena() = default;
+  JsonArena(JsonArena const&) = delete;
+
+  [[nodiscard]] Tracks::ffi::FFIJsonValue const* Convert(rapidjson::Value const& value);
+  /// Keeps the blocks for the next conversion
+  void Reset();
+  /// Frees every block
+  void Release();
+  [[nodiscard]] size_t Capacity() const;
+
+  /// One per thread, point definitions can be built from any thread
+  static JsonArena& ForThread();
+  /// Frees the calling thread's arena now and every other thread's on its next Convert, call between maps
+  static void ReleaseAll();
+
+private:
+  template <typename T> T* Allocate(size_t count);
+
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    size_t size;
+  };
+
+  static constexpr size_t blockBytes = 16 * 1024;
+
+  std::vector<Block> blocks;
+  size_t block = 0;
+  size_t offset = 0;
+  // ReleaseAll count this arena last caught up with
+  uint32_t releases = 0;
+};
+
+/// Leaks the tree, prefer ConvertedJson or JsonArena
 extern Tracks::ffi::FFIJsonValue const* convert_rapidjson(rapidjson::Value const& value);
 
+/// Trees handed out by convert_rapidjson, they are never freed
+struct ConvertRapidjsonStats {
+  size_t nodes;
+  size_t bytes;
+};
+ConvertRapidjsonStats GetConvertRapidjsonStats();
+
+/// 64-bit hash of a point array, equal for values convert_rapidjson turns into the same tree
+uint64_t CanonicalPointDataHash(rapidjson::Value const& value);
+
+class PointDefinitionW;
+
+/**
+ * @brief A point definition sampled at load into a lookup table, opt in through PointDefinitionW::Bake.
+ *
+ * Only definitions without base provider values can be baked, those are pure functions of time.
+ * Covers times in [0, 1], interpolating is a segment lookup and one lerp (nlerp for quaternions) instead of a segment
+ * search and easing in tracks_rs. The table is refined until the error measured at the middle and quarters of every
+ * segment is within the tolerance, uniformly while that fits maxResolution and only where needed after that. Adaptive tables are
+ * searched, a PointDefinitionCursor walks them forward instead.
+ */
+class BakedPointDefinition {
+public:
+  struct Options {
+    uint32_t resolution = 256;
+    uint32_t maxResolution = 4096;
+    // rows of an adaptive table, tried once maxResolution is not enough. 0 only bakes uniform tables, those never
+    // need a search
+    uint32_t maxSamples = 0;
+    // max absolute difference of any component
+    float tolerance = 1e-3f;
+  };
+
+  /// Empty if the definition has base provider values or is not smooth enough to bake within the tolerance
+  [[nodiscard]] static std::optional<BakedPointDefinition> Bake(PointDefinitionW const& definition, Options options);
+
+  [[nodiscard]] bool Covers(float time) const {
+    return time >= 0 && time <= 1;
+  }
+
+  /// Segment holding time, which must be covered. Adaptive tables gallop forward from hint, so the search only
+  /// spans the distance advanced, and from the start when time went back
+  [[nodiscard]] uint32_t FindSegment(float time, uint32_t hint) const {
+    if (times.empty()) {
+      return std::min(static_cast<uint32_t>(time * float(resolution)), resolution - 1);
+    }
+
+    uint32_t low = hint < resolution && times[hint] <= time ? hint : 0;
+    uint32_t step = 1;
+    while (low + step < resolution && times[low + step] <= time) {
+      low += step;
+      step *= 2;
+    }
+    // times[high] is past time, or the end which belongs to the last segment
+    auto high = std::min(low + step, resolution);
+    auto next = std::upper_bound(times.begin() + low + 1, times.begin() + high, time);
+    return static_cast<uint32_t>(next - times.begin()) - 1;
+  }
+
+  /// components of the value at time, which must be covered. segment is the hint for FindSegment and is left at
+  /// the segment of time
+  void Sample(float time, float* out, bool& last, uint32_t& segment) const {
+    segment = FindSegment(time, segment);
+    float fraction = times.empty() ? time * float(resolution) - float(segment)
+                                   : (time - times[segment]) / (times[segment + 1] - times[segment]);
+
+    auto const* a = &samples[segment * components];
+    auto const* b = a + components;
+    for (uint32_t c = 0; c < components; c++) {
+      out[c] = a[c] + (b[c] - a[c]) * fraction;
+    }
+    last = time >= lastTime;
+  }
+  void Sample(float time, float* out, bool& last) const {
+    uint32_t segment = 0;
+    Sample(time, out, last, segment);
+  }
+
+  [[nodiscard]] NEVector::Vector3 InterpolateVec3(float time, bool& last, uint32_t& segment) const {
+    float v[3];
+    Sample(time, v, last, segment);
+    return { v[0], v[1], v[2] };
+  }
+  [[nodiscard]] NEVector::Quaternion InterpolateQuaternion(float time, bool& last, uint32_t& segment) const {
+    float v[4];
+    Sample(time, v, last, segment);
+    float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
+    if (length > 0) {
+      for (auto& component : v) component /= length;
+    }
+    return { v[0], v[1], v[2], v[3] };
+  }
+  [[nodiscard]] NEVector::Vector4 InterpolateVector4(float time, bool& last, uint32_t& segment) const {
+    float v[4];
+    Sample(time, v, last, segment);
+    return { v[0], v[1], v[2], v[3] };
+  }
+  [[nodiscard]] float InterpolateLinear(float time, bool& last, uint32_t& segment) const {
+    float v;
+    Sample(time, &v, last, segment);
+    return v;
+  }
+
+  [[nodiscard]] NEVector::Vector3 InterpolateVec3(float time, bool& last) const {
+    uint32_t segment = 0;
+    return InterpolateVec3(time, last, segment);
+  }
+  [[nodiscard]] NEVector::Quaternion InterpolateQuaternion(float time, bool& last) const {
+    uint32_t segment = 0;
+    return InterpolateQuaternion(time, last, segment);
+  }
+  [[nodiscard]] NEVector::Vector4 InterpolateVector4(float time, bool& last) const {
+    uint32_t segment = 0;
+    return InterpolateVector4(time, last, segment);
+  }
+  [[nodiscard]] float InterpolateLinear(float time, bool& last) const {
+    uint32_t segment = 0;
+    return InterpolateLinear(time, last, segment);
+  }
+
+  [[nodiscard]] Tracks::ffi::WrapBaseValueType GetType() const {
+    return type;
+  }
+  /// Segments of the table
+  [[nodiscard]] uint32_t Resolution() const {
+    return resolution;
+  }
+  /// Whether the segments have different lengths, those are searched
+  [[nodiscard]] bool IsAdaptive() const {
+    return !times.empty();
+  }
+  /// Largest difference to the definition measured while baking. Not a bound, the definition is only compared at
+  /// the middle and quarters of each segment. Above the tolerance where an adaptive table narrowed a jump, such as
+  /// a step easing, to its narrowest segment
+  [[nodiscard]] float MeasuredError() const {
+    return measuredError;
+  }
+
+private:
+  BakedPointDefinition() = default;
+
+  // resolution + 1 rows of components floats
+  std::vector<float> samples;
+  // time of each row of an adaptive table, empty for uniform ones
+  std::vector<float> times;
+  Tracks::ffi::WrapBaseValueType type = Tracks::ffi::WrapBaseValueType::Unknown;
+  uint32_t components = 0;
+  uint32_t resolution = 0;
+  float measuredError = 0;
+  // first time the definition reports its last point, infinity if not within [0, 1]
+  float lastTime = 0;
+};
+
 class PointDefinitionW {
 public:
   explicit PointDefinitionW(rapidjson::Value const& value, Tracks::ffi::WrapBaseValueType type,
                             std::shared_ptr<TracksAD::BaseProviderContextW> base_provider_context) {
-    auto* json = convert_rapidjson(value);
+    // tracks_rs copies what it needs, the scratch tree is reused by the next definition
+    auto const* json = JsonArena::ForThread().Convert(value);
     this->base_provider_context = base_provider_context;
 
     internalPointDefinition = std::shared_ptr<Tracks::ffi::BasePointDefinition>(
-        Tracks::ffi::tracks_make_base_point_definition(json, type, *base_provider_context),
+        TRACKS_FFI(tracks_make_base_point_definition)(json, type, *base_provider_context),
         [](Tracks::ffi::BasePointDefinition* ptr) {
           if (!ptr) return;
-          Tracks::ffi::base_point_definition_free(ptr);
+          TRACKS_FFI(base_point_definition_free)(ptr);
         });
   }
 
@@ -38,7 +271,7 @@ public:
         pointDefinition,
         [](Tracks::ffi::BasePointDefinition* ptr) {
           if (!ptr) return;
-          Tracks::ffi::base_point_definition_free(ptr);
+          TRACKS_FFI(base_point_definition_free)(ptr);
         });
   }
 
@@ -49,7 +282,7 @@ public:
 
   [[nodiscard]]
   Tracks::ffi::WrapBaseValueType GetType() const {
-    return Tracks::ffi::tracks_base_point_definition_get_type(internalPointDefinition.get());
+    return TRACKS_FFI(tracks_base_point_definition_get_type)(internalPointDefinition.get());
   }
 
   [[nodiscard]]
@@ -60,27 +293,31 @@ public:
   }
 
   Tracks::ffi::WrapBaseValue Interpolate(float time, bool& last) const {
-    auto result = Tracks::ffi::tracks_interpolate_base_point_definition(internalPointDefinition.get(), time, &last,
-                                                                        *base_provider_context);
+    auto result = TRACKS_FFI(tracks_interpolate_base_point_definition)(internalPointDefinition.get(), time, &last,
+                                                                       *base_provider_context);
 
     return result;
   }
   NEVector::Vector3 InterpolateVec3(float time, bool& last) const {
+    if (baked && baked->Covers(time)) return baked->InterpolateVec3(time, last);
     auto result = Interpolate(time, last);
     return { result.value.vec3.x, result.value.vec3.y, result.value.vec3.z };
   }
 
   NEVector::Quaternion InterpolateQuaternion(float time, bool& last) const {
+    if (baked && baked->Covers(time)) return baked->InterpolateQuaternion(time, last);
     auto result = Interpolate(time, last);
     return { result.value.quat.x, result.value.quat.y, result.value.quat.z, result.value.quat.w };
   }
 
   float InterpolateLinear(float time, bool& last) const {
+    if (baked && baked->Covers(time)) return baked->InterpolateLinear(time, last);
     auto result = Interpolate(time, last);
     return result.value.float_v;
   }
 
   NEVector::Vector4 InterpolateVector4(float time, bool& last) const {
+    if (baked && baked->Covers(time)) return baked->InterpolateVector4(time, last);
     auto result = Interpolate(time, last);
     return { result.value.vec4.x, result.value.vec4.y, result.value.vec4.z, result.value.vec4.w };
   }
@@ -106,11 +343,25 @@ public:
   }
 
   uintptr_t count() const {
-    return Tracks::ffi::tracks_base_point_definition_count(internalPointDefinition.get());
+    return TRACKS_FFI(tracks_base_point_definition_count)(internalPointDefinition.get());
+  }
+
+  /// Switches the typed Interpolate* calls to a baked table, false if the definition can't be baked.
+  /// Only tried once, the table is shared by every copy made afterwards
+  bool Bake(BakedPointDefinition::Options options = {}) {
+    if (bakeAttempted) return baked != nullptr;
+    bakeAttempted = true;
+    auto table = BakedPointDefinition::Bake(*this, options);
+    if (!table) return false;
+    baked = std::make_shared<BakedPointDefinition const>(std::move(*table));
+    return true;
+  }
+  [[nodiscard]] BakedPointDefinition const* GetBaked() const {
+    return baked.get();
   }
 
   bool hasBaseProvider() const {
-    return Tracks::ffi::tracks_base_point_definition_has_base_provider(internalPointDefinition.get());
+    return TRACKS_FFI(tracks_base_point_definition_has_base_provider)(internalPointDefinition.get());
   }
 
   operator Tracks::ffi::BasePointDefinition const*() const {
@@ -131,6 +382,63 @@ private:
 
   std::shared_ptr<Tracks::ffi::BasePointDefinition> internalPointDefinition;
   std::shared_ptr<TracksAD::BaseProviderContextW> base_provider_context;
+  std::shared_ptr<BakedPointDefinition const> baked;
+  bool bakeAttempted = false;
+};
+
+/**
+ * @brief Interpolates one definition at times that mostly move forward, e.g. one animation as its song time advances.
+ *
+ * Remembers the segment of the last sample of the baked table, so advancing is amortized O(1) on long adaptive
+ * tables. Going back, like seeking or restarting, falls back to a binary search. The points themselves live in
+ * tracks_rs, so a definition that was never baked gets an adaptive table when the cursor is made. Bake it before
+ * to share one table between cursors, every cursor keeps its own copy. Definitions with base provider values can't
+ * be baked and are interpolated by tracks_rs as usual. One cursor per animated object, it is not shared between
+ * threads.
+ */
+class PointDefinitionCursor {
+public:
+  /// What a cursor bakes a definition with when that was not tried yet
+  static constexpr BakedPointDefinition::Options bakeOptions{ .maxSamples = 1 << 16 };
+
+  explicit PointDefinitionCursor(PointDefinitionW definition, BakedPointDefinition::Options options = bakeOptions)
+      : definition(std::move(definition)) {
+    this->definition.Bake(options);
+  }
+
+  NEVector::Vector3 InterpolateVec3(float time, bool& last) {
+    auto const* baked = definition.GetBaked();
+    if (baked && baked->Covers(time)) return baked->InterpolateVec3(time, last, segment);
+    return definition.InterpolateVec3(time, last);
+  }
+  NEVector::Quaternion InterpolateQuaternion(float time, bool& last) {
+    auto const* baked = definition.GetBaked();
+    if (baked && baked->Covers(time)) return baked->InterpolateQuaternion(time, last, segment);
+    return definition.InterpolateQuaternion(time, last);
+  }
+  float InterpolateLinear(float time, bool& last) {
+    auto const* baked = definition.GetBaked();
+    if (baked && baked->Covers(time)) return baked->InterpolateLinear(time, last, segment);
+    return definition.InterpolateLinear(time, last);
+  }
+  NEVector::Vector4 InterpolateVector4(float time, bool& last) {
+    auto const* baked = definition.GetBaked();
+    if (baked && baked->Covers(time)) return baked->InterpolateVector4(time, last, segment);
+    return definition.InterpolateVector4(time, last);
+  }
+
+  /// Forgets the last segment, the next sample searches from the start
+  void Reset() {
+    segment = 0;
+  }
+
+  [[nodiscard]] PointDefinitionW const& GetDefinition() const {
+    return definition;
+  }
+
+private:
+  PointDefinitionW definition;
+  uint32_t segment = 0;
 };
 
 class PointDefinitionManager {
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "PointDefinition.h"
+
+namespace Tracks {
+
+/// One sample of a batch, the definition must outlive the call
+struct PointSample {
+  PointDefinitionW const* definition;
+  float time;
+};
+
+/**
+ * @brief Interpolates many (definition, time) samples into struct of arrays outputs.
+ *
+ * Every output span must be at least samples.size() long, last may be empty when not needed.
+ * Samples are evaluated grouped by definition in time order, each definition's baked table is walked forward once
+ * instead of searched per sample and samples of the same definition and time share one result. Definitions that are
+ * not baked still cross the FFI once per distinct time. Outputs stay in the order of samples, passing them already
+ * sorted by definition and time skips sorting.
+ */
+void InterpolateVec3Batch(std::span<PointSample const> samples, std::span<float> xs, std::span<float> ys,
+                          std::span<float> zs, std::span<bool> last = {});
+void InterpolateQuaternionBatch(std::span<PointSample const> samples, std::span<float> xs, std::span<float> ys,
+                                std::span<float> zs, std::span<float> ws, std::span<bool> last = {});
+void InterpolateVector4Batch(std::span<PointSample const> samples, std::span<float> xs, std::span<float> ys,
+                             std::span<float> zs, std::span<float> ws, std::span<bool> last = {});
+void InterpolateLinearBatch(std::span<PointSample const> samples, std::span<float> values,
+                            std::span<bool> last = {});
+
+} // namespace Tracks
@@ -15,6 +15,7 @@
 #include <chrono>
 
 #include "../bindings.h"
+#include "../FfiAccounting.h"
 #include "../binding_wrappers.hpp"
 
 namespace Events {
@@ -74,6 +75,58 @@ struct TimeUnit {
   }
 };
 
+/// A property value along with the TracksHolderW::writeEpoch it was first seen written at
+template <typename T> struct StampedValue {
+  std::optional<T> value;
+  uint64_t changedEpoch = 0;
+
+  /// Everything for a lastCheckedEpoch of 0, otherwise only values written after it
+  [[nodiscard]] constexpr std::optional<T> Since(uint64_t lastCheckedEpoch) const {
+    if (lastCheckedEpoch != 0 && changedEpoch <= lastCheckedEpoch) return std::nullopt;
+    return value;
+  }
+
+  [[nodiscard]] constexpr bool NewerThan(uint64_t epoch) const {
+    return value.has_value() && changedEpoch > epoch;
+  }
+};
+
+/// Everything GameObjectTrackController needs from a track in a frame
+struct TransformSnapshot {
+  StampedValue<NEVector::Vector3> position;
+  StampedValue<NEVector::Vector3> localPosition;
+  StampedValue<NEVector::Quaternion> rotation;
+  StampedValue<NEVector::Quaternion> localRotation;
+  StampedValue<NEVector::Vector3> scale;
+};
+
+/**
+ * @brief A property name resolved once, then used for every lookup and event built from it.
+ *
+ * Built-in names become PropertyNames and go through the *_by_name calls, anything else is interned for the lifetime
+ * of the process so the FFI always gets a NUL terminated string, whatever view the handle was resolved from.
+ */
+struct PropertyHandle {
+  PropertyNames name = PropertyNames::UnknownPropertyName;
+  // interned, only set for names tracks_rs does not know
+  char const* custom = nullptr;
+
+  /// Thread safe, every name is converted at most once
+  [[nodiscard]] static PropertyHandle Resolve(std::string_view name);
+
+  [[nodiscard]] bool IsNamed() const {
+    return name != PropertyNames::UnknownPropertyName;
+  }
+
+  [[nodiscard]] Tracks::ffi::CEventPropertyId EventPropertyId() const {
+    return IsNamed() ? Tracks::ffi::CEventPropertyId{ .property_name = name }
+                     : Tracks::ffi::CEventPropertyId{ .property_str = custom };
+  }
+  [[nodiscard]] Tracks::ffi::CEventPropertyIdType EventPropertyIdType() const {
+    return IsNamed() ? Tracks::ffi::CEventPropertyIdType::PropertyName : Tracks::ffi::CEventPropertyIdType::CString;
+  }
+};
+
 /// Owned by TrackW
 struct PropertyW {
   Tracks::ffi::ValueProperty* property;
@@ -94,17 +147,17 @@ struct PropertyW {
   [[nodiscard]] Tracks::ffi::WrapBaseValueType GetType() const {
     CRASH_UNLESS(property);
 
-    return Tracks::ffi::property_get_type(property);
+    return TRACKS_FFI(property_get_type)(property);
   }
   [[nodiscard]] Tracks::ffi::CValueProperty GetValue() const {
     CRASH_UNLESS(property);
-    return Tracks::ffi::property_get_value(property);
+    return TRACKS_FFI(property_get_value)(property);
   }
 
   [[nodiscard]] TimeUnit GetTime() const {
     CRASH_UNLESS(property);
 
-    return Tracks::ffi::property_get_last_updated(property);
+    return TRACKS_FFI(property_get_last_updated)(property);
   }
 
   constexpr bool hasUpdated(Tracks::ffi::CValueProperty value, TimeUnit lastCheckedTime = {}) const {
@@ -151,6 +204,25 @@ struct PropertyW {
 
     return value.value.value.value.float_v;
   }
+
+  [[nodiscard]] static StampedValue<NEVector::Quaternion> StampedQuat(Tracks::ffi::CValueNullable const& value,
+                                                                      uint64_t changedEpoch) {
+    StampedValue<NEVector::Quaternion> stamped{ .value = std::nullopt, .changedEpoch = changedEpoch };
+    if (value.has_value && value.value.ty == Tracks::ffi::WrapBaseValueType::Quat) {
+      auto v = value.value.value;
+      stamped.value = NEVector::Quaternion{ v.quat.x, v.quat.y, v.quat.z, v.quat.w };
+    }
+    return stamped;
+  }
+  [[nodiscard]] static StampedValue<NEVector::Vector3> StampedVec3(Tracks::ffi::CValueNullable const& value,
+                                                                   uint64_t changedEpoch) {
+    StampedValue<NEVector::Vector3> stamped{ .value = std::nullopt, .changedEpoch = changedEpoch };
+    if (value.has_value && value.value.ty == Tracks::ffi::WrapBaseValueType::Vec3) {
+      auto v = value.value.value;
+      stamped.value = NEVector::Vector3{ v.vec3.x, v.vec3.y, v.vec3.z };
+    }
+    return stamped;
+  }
 };
 
 /// Owned by TrackW
@@ -173,12 +245,12 @@ struct PathPropertyW {
 
   [[nodiscard]]
   float GetTime() const {
-    return Tracks::ffi::path_property_get_time(property);
+    return TRACKS_FFI(path_property_get_time)(property);
   }
 
   [[nodiscard]]
   std::optional<Tracks::ffi::WrapBaseValue> Interpolate(float time) const {
-    auto result = Tracks::ffi::path_property_interpolate(property, time, *this->internal_tracks_context);
+    auto result = TRACKS_FFI(path_property_interpolate)(property, time, *this->internal_tracks_context);
     if (!result.has_value) {
       return std::nullopt;
     }
@@ -236,23 +308,23 @@ struct PathPropertyW {
   }
 
   [[nodiscard]] Tracks::ffi::WrapBaseValueType GetType() const {
-    return Tracks::ffi::path_property_get_type(property);
+    return TRACKS_FFI(path_property_get_type)(property);
   }
 
   // [[nodiscard]] float GetTime() const {
-  //   return Tracks::ffi::path_property_get_time(property);
+  //   return TRACKS_FFI(path_property_get_time)(property);
   // }
 
   // void SetTime(float time) const {
-  //   Tracks::ffi::path_property_set_time(property, time);
+  //   TRACKS_FFI(path_property_set_time)(property, time);
   // }
 
   // void Finish() const {
-  //   Tracks::ffi::path_property_finish(property);
+  //   TRACKS_FFI(path_property_finish)(property);
   // }
 
   // void Init(std::optional<PointDefinitionW> newPointData) const {
-  //   Tracks::ffi::path_property_init(property, newPointData.value_or(PointDefinitionW(nullptr)));
+  //   TRACKS_FFI(path_property_init)(property, newPointData.value_or(PointDefinitionW(nullptr)));
   // }
 };
 struct PropertiesMapW {
@@ -424,8 +496,25 @@ struct TrackW {
   std::shared_ptr<TracksAD::BaseProviderContextW> base_provider_context;
   bool v2;
 
+  // resolved by getTrackPtr, valid while cachedGeneration matches the holder's generation
+  mutable Tracks::ffi::Track* cachedTrack = nullptr;
+  mutable uint64_t cachedGeneration = 0;
+
+  struct TransformProperties {
+    PropertyW position{ nullptr };
+    PropertyW localPosition{ nullptr };
+    PropertyW rotation{ nullptr };
+    PropertyW localRotation{ nullptr };
+    PropertyW scale{ nullptr };
+  };
+  // the properties live inside the track, so they share its generation
+  mutable TransformProperties cachedTransform;
+  mutable uint64_t cachedTransformGeneration = 0;
+  // owned by the holder, stays valid for its lifetime
+  mutable TracksAD::TrackTransformState* cachedTransformState = nullptr;
+
   // using CWrappedCallback = void (* *)(struct Tracks::ffi::GameObject, bool, void*);
-  using CWrappedCallback = decltype(Tracks::ffi::track_register_game_object_callback(nullptr, nullptr, nullptr));
+  using CWrappedCallback = decltype(TRACKS_FFI(track_register_game_object_callback)(nullptr, nullptr, nullptr));
 
   constexpr TrackW() = default;
   TrackW(Tracks::ffi::TrackKeyFFI track, bool v2, std::shared_ptr<TracksAD::TracksHolderW> internal_tracks_context,
@@ -450,7 +539,76 @@ struct TrackW {
   }
 
   [[nodiscard]] Tracks::ffi::Track* getTrackPtr() const {
-    return Tracks::ffi::tracks_holder_get_track_mut(*internal_tracks_context, track);
+    auto generation = internal_tracks_context->generation;
+    if (cachedGeneration != generation) [[unlikely]] {
+      cachedTrack = TRACKS_FFI(tracks_holder_get_track_mut)(*internal_tracks_context, track);
+      cachedGeneration = generation;
+    }
+    return cachedTrack;
+  }
+
+  [[nodiscard]] TransformProperties const& getTransformProperties() const {
+    auto generation = internal_tracks_context->generation;
+    if (cachedTransformGeneration != generation) [[unlikely]] {
+      auto map = TRACKS_FFI(track_get_properties_map)(getTrackPtr());
+      cachedTransform = { map.position, map.local_position, map.rotation, map.local_rotation, map.scale };
+      cachedTransformGeneration = generation;
+    }
+    return cachedTransform;
+  }
+
+  /// Transform property values as of the current write epoch, stamped with the epochs they were seen changing at.
+  /// No FFI calls past the first snapshot or generation of the track in an epoch
+  [[nodiscard]] TransformSnapshot GetTransformSnapshot() const {
+    RefreshTransformState();
+    auto const& state = *cachedTransformState;
+    auto const& epochs = state.changedEpochs;
+    return TransformSnapshot{
+      .position = PropertyW::StampedVec3(state.values[0], epochs[0]),
+      .localPosition = PropertyW::StampedVec3(state.values[1], epochs[1]),
+      .rotation = PropertyW::StampedQuat(state.values[2], epochs[2]),
+      .localRotation = PropertyW::StampedQuat(state.values[3], epochs[3]),
+      .scale = PropertyW::StampedVec3(state.values[4], epochs[4]),
+    };
+  }
+
+  /// Bumped whenever any of the transform properties of this track was written
+  [[nodiscard]] uint64_t GetTransformGeneration() const {
+    RefreshTransformState();
+    return cachedTransformState->generation;
+  }
+
+  /// Reads the transform properties with their stamps once per write epoch, no matter how many TrackW share the
+  /// track. One value read per property, the stamp comes with it
+  void RefreshTransformState() const {
+    if (!cachedTransformState) [[unlikely]] {
+      cachedTransformState = &internal_tracks_context->GetTransformState(track);
+    }
+    auto& state = *cachedTransformState;
+    auto epoch = internal_tracks_context->writeEpoch;
+    if (state.checkedEpoch == epoch) {
+      return;
+    }
+    state.checkedEpoch = epoch;
+
+    auto const& properties = getTransformProperties();
+    std::array<PropertyW, TracksAD::TrackTransformState::propertyCount> const ordered = {
+      properties.position, properties.localPosition, properties.rotation, properties.localRotation, properties.scale
+    };
+    bool changed = false;
+    for (size_t i = 0; i < ordered.size(); i++) {
+      auto value = ordered[i].GetValue();
+      state.values[i] = value.value;
+      auto& stamp = state.stamps[i];
+      if (value.last_updated._0 != stamp._0 || value.last_updated._1 != stamp._1) {
+        stamp = value.last_updated;
+        state.changedEpochs[i] = epoch;
+        changed = true;
+      }
+    }
+    if (changed) {
+      state.generation++;
+    }
   }
 
   Tracks::ffi::PropertyNames AliasPropertyName(Tracks::ffi::PropertyNames original) const {
@@ -471,64 +629,72 @@ struct TrackW {
     return original;
   }
 
-  [[nodiscard]] PropertyW GetProperty(std::string_view name) const {
+  [[nodiscard]] PropertyW GetProperty(PropertyHandle property) const {
+    if (property.IsNamed()) return GetPropertyNamed(property.name);
     auto ptr = getTrackPtr();
-    auto prop = Tracks::ffi::track_get_property(ptr, AliasPropertyName(name).data());
+    auto prop = TRACKS_FFI(track_get_property)(ptr, property.custom);
     return PropertyW(prop);
   }
+  [[nodiscard]] PropertyW GetProperty(std::string_view name) const {
+    return GetProperty(PropertyHandle::Resolve(name));
+  }
   [[nodiscard]] PropertyW GetPropertyNamed(Tracks::ffi::PropertyNames name) const {
     auto ptr = getTrackPtr();
-    auto prop = Tracks::ffi::track_get_property_by_name(ptr, AliasPropertyName(name));
+    auto prop = TRACKS_FFI(track_get_property_by_name)(ptr, AliasPropertyName(name));
     return PropertyW(prop);
   }
 
-  [[nodiscard]] PathPropertyW GetPathProperty(std::string_view name) const {
+  [[nodiscard]] PathPropertyW GetPathProperty(PropertyHandle property) const {
+    if (property.IsNamed()) return GetPathPropertyNamed(property.name);
     auto ptr = getTrackPtr();
-    auto prop = Tracks::ffi::track_get_path_property(ptr, AliasPropertyName(name).data());
+    auto prop = TRACKS_FFI(track_get_path_property)(ptr, property.custom);
     return PathPropertyW(prop, base_provider_context);
   }
+  [[nodiscard]] PathPropertyW GetPathProperty(std::string_view name) const {
+    return GetPathProperty(PropertyHandle::Resolve(name));
+  }
   [[nodiscard]] PathPropertyW GetPathPropertyNamed(Tracks::ffi::PropertyNames name) const {
     auto track = getTrackPtr();
-    auto prop = Tracks::ffi::track_get_path_property_by_name(getTrackPtr(), AliasPropertyName(name));
+    auto prop = TRACKS_FFI(track_get_path_property_by_name)(track, AliasPropertyName(name));
     return PathPropertyW(prop, base_provider_context);
   }
 
   [[nodiscard]]
   PropertiesMapW GetPropertiesMapW() const {
     auto track = getTrackPtr();
-    auto map = Tracks::ffi::track_get_properties_map(track);
+    auto map = TRACKS_FFI(track_get_properties_map)(track);
     return PropertiesMapW(map);
   }
 
   [[nodiscard]]
   PathPropertiesMapW GetPathPropertiesMapW() const {
     auto track = getTrackPtr();
-    auto map = Tracks::ffi::track_get_path_properties_map(track);
+    auto map = TRACKS_FFI(track_get_path_properties_map)(track);
     return PathPropertiesMapW(map, base_provider_context);
   }
 
   [[nodiscard]]
   PropertiesValuesW GetPropertiesValuesW() const {
     auto track = getTrackPtr();
-    auto values = Tracks::ffi::track_get_properties_values(track);
+    auto values = TRACKS_FFI(track_get_properties_values)(track);
     return PropertiesValuesW(values);
   }
 
   [[nodiscard]]
   PathPropertiesValuesW GetPathPropertiesValuesW(float time) const {
     auto track = getTrackPtr();
-    auto values = Tracks::ffi::track_get_path_properties_values(track, time, *base_provider_context);
+    auto values = TRACKS_FFI(track_get_path_properties_values)(track, time, *base_provider_context);
     return PathPropertiesValuesW(values);
   }
 
   void RegisterGameObject(UnityEngine::GameObject* gameObject) const {
     auto ptr = getTrackPtr();
-    Tracks::ffi::track_register_game_object(ptr, Tracks::ffi::GameObject{ .ptr = gameObject });
+    TRACKS_FFI(track_register_game_object)(ptr, Tracks::ffi::GameObject{ .ptr = gameObject });
   }
 
   void UnregisterGameObject(UnityEngine::GameObject* gameObject) const {
     auto track = getTrackPtr();
-    Tracks::ffi::track_unregister_game_object(track, Tracks::ffi::GameObject{ .ptr = gameObject });
+    TRACKS_FFI(track_unregister_game_object)(track, Tracks::ffi::GameObject{ .ptr = gameObject });
   }
 
   // very nasty
@@ -550,7 +716,7 @@ struct TrackW {
     };
 
     auto track = getTrackPtr();
-    return Tracks::ffi::track_register_game_object_callback(track, wrapper, callbackPtr);
+    return TRACKS_FFI(track_register_game_object_callback)(track, wrapper, callbackPtr);
   }
 
   void RemoveGameObjectCallback(CWrappedCallback callback) const {
@@ -559,26 +725,38 @@ struct TrackW {
     }
 
     auto track = getTrackPtr();
-    Tracks::ffi::track_remove_game_object_callback(track, callback);
+    TRACKS_FFI(track_remove_game_object_callback)(track, callback);
   }
 
   void RegisterProperty(std::string_view id, PropertyW property) {
     auto track = getTrackPtr();
-    Tracks::ffi::track_register_property(track, id.data(), const_cast<Tracks::ffi::ValueProperty*>(property.property));
+    TRACKS_FFI(track_register_property)(track, id.data(), const_cast<Tracks::ffi::ValueProperty*>(property.property));
+    // may have replaced a transform property, the cached pointers of every track are re-resolved
+    internal_tracks_context->generation++;
+    internal_tracks_context->MarkWritten();
+  }
+
+  /// Resets every property of the track
+  void Reset() const {
+    auto track = getTrackPtr();
+    TRACKS_FFI(track_reset)(track);
+    // may rebuild the property map, like RegisterProperty
+    internal_tracks_context->generation++;
+    internal_tracks_context->MarkWritten();
   }
   void RegisterPathProperty(std::string_view id, PathPropertyW property) const {
     auto track = getTrackPtr();
-    Tracks::ffi::track_register_path_property(track, id.data(), property);
+    TRACKS_FFI(track_register_path_property)(track, id.data(), property);
   }
 
   [[nodiscard]] Tracks::ffi::CPropertiesMap GetPropertiesMap() const {
     auto track = getTrackPtr();
-    return Tracks::ffi::track_get_properties_map(track);
+    return TRACKS_FFI(track_get_properties_map)(track);
   }
 
   [[nodiscard]] Tracks::ffi::CPathPropertiesMap GetPathPropertiesMap() const {
     auto track = getTrackPtr();
-    return Tracks::ffi::track_get_path_properties_map(track);
+    return TRACKS_FFI(track_get_path_properties_map)(track);
   }
 
   /**
@@ -588,7 +766,7 @@ struct TrackW {
    */
   [[nodiscard]] std::string_view GetName() const {
     auto track = getTrackPtr();
-    return Tracks::ffi::track_get_name(track);
+    return TRACKS_FFI(track_get_name)(track);
   }
 
   /**
@@ -598,7 +776,10 @@ struct TrackW {
    */
   void SetName(std::string_view name) const {
     auto track = getTrackPtr();
-    Tracks::ffi::track_set_name(track, name.data());
+    // the view might not be NUL terminated
+    std::string ownedName(name);
+    TRACKS_FFI(track_set_name)(track, ownedName.c_str());
+    internal_tracks_context->RenameTrackKey(this->track, name);
   }
 
   [[nodiscard]] std::span<UnityEngine::GameObject* const> GetGameObjects() const {
@@ -606,7 +787,7 @@ struct TrackW {
                   "Tracks wrapper and GameObject pointer do not match size!");
     std::size_t count = 0;
     auto track = getTrackPtr();
-    auto const* ptr = Tracks::ffi::track_get_game_objects(track, &count);
+    auto const* ptr = TRACKS_FFI(track_get_game_objects)(track, &count);
     auto const* castedPtr = reinterpret_cast<UnityEngine::GameObject* const*>(ptr);
 
     return std::span<UnityEngine::GameObject* const>(castedPtr, count);
@@ -7,6 +7,8 @@
 #include "UnityEngine/Transform.hpp"
 #include "GlobalNamespace/StaticBeatmapObjectSpawnMovementData.hpp"
 
+#include "TransformWriter.hpp"
+
 
 namespace Tracks {
     struct TransformData {
@@ -41,7 +43,8 @@ namespace Tracks {
             Apply(transform, leftHanded, false);
         }
 
-        void Apply(UnityEngine::Transform* transform, bool leftHanded, bool v2) const {
+        /// with skipUnchanged, local values the transform already holds are not written again
+        void Apply(UnityEngine::Transform* transform, bool leftHanded, bool v2, bool skipUnchanged = false) const {
             auto position = this->position;
             auto localPosition = this->localPosition;
             auto rotation = this->rotation;
@@ -68,21 +71,10 @@ namespace Tracks {
             }
 
 
-            if (localPosition) {
-                transform->set_localPosition(*localPosition);
-            }else if (position) {
-                transform->set_position(*position);
-            }
-
-            if (localRotation) {
-                transform->set_localRotation(*localRotation);
-            } else if (rotation) {
-                transform->set_rotation(*rotation);
-            }
-
-            if (scale) {
-                transform->set_localScale(*scale);
-            }
+            bool useLocalPosition = localPosition.has_value();
+            bool useLocalRotation = localRotation.has_value();
+            WriteTransform(transform, useLocalPosition ? localPosition : position, useLocalPosition,
+                           useLocalRotation ? localRotation : rotation, useLocalRotation, scale, skipUnchanged);
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#include "../Vector.h"
+
+#include "UnityEngine/Transform.hpp"
+
+namespace Tracks {
+
+/// What WriteTransform ended up writing
+enum TransformWritten : uint8_t {
+  WrotePosition = 1 << 0,
+  WroteRotation = 1 << 1,
+  WroteScale = 1 << 2,
+};
+
+template <typename T> [[nodiscard]] inline bool BitIdentical(T const& a, T const& b) {
+  return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+/**
+ * @brief Writes position, rotation and scale with as few transform changes as possible.
+ *
+ * Position and rotation in the same space go through one SetPositionAndRotation/SetLocalPositionAndRotation,
+ * every one of those calls invalidates the whole hierarchy below the transform.
+ * With skipUnchanged, local values bit identical to what the transform currently holds are not written. Those are
+ * read back from the transform, so writes by anything else are never missed. World space values depend on the
+ * parents and are always written.
+ * @return TransformWritten flags
+ */
+inline uint8_t WriteTransform(UnityEngine::Transform* transform, std::optional<NEVector::Vector3> const& position,
+                              bool localPosition, std::optional<NEVector::Quaternion> const& rotation,
+                              bool localRotation, std::optional<NEVector::Vector3> const& scale,
+                              bool skipUnchanged = false) {
+  static auto Transform_Position =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_position>::get();
+  static auto Transform_LocalPosition =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_localPosition>::get();
+  static auto Transform_Rotation =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_rotation>::get();
+  static auto Transform_LocalRotation =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_localRotation>::get();
+  static auto Transform_PositionAndRotation =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::SetPositionAndRotation>::get();
+  static auto Transform_LocalPositionAndRotation =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::SetLocalPositionAndRotation>::get();
+  static auto Transform_Scale =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_localScale>::get();
+  static auto Transform_GetLocalPosition =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::get_localPosition>::get();
+  static auto Transform_GetLocalRotation =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::get_localRotation>::get();
+  static auto Transform_GetScale =
+      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::get_localScale>::get();
+
+  bool writePosition = position.has_value();
+  bool writeRotation = rotation.has_value();
+  bool writeScale = scale.has_value();
+  // local values are stored on the transform, reading them back does not touch the hierarchy
+  if (skipUnchanged) {
+    if (writePosition && localPosition &&
+        BitIdentical<NEVector::Vector3>(Transform_GetLocalPosition(transform), *position)) {
+      writePosition = false;
+    }
+    if (writeRotation && localRotation &&
+        BitIdentical<NEVector::Quaternion>(Transform_GetLocalRotation(transform), *rotation)) {
+      writeRotation = false;
+    }
+    if (writeScale && BitIdentical<NEVector::Vector3>(Transform_GetScale(transform), *scale)) {
+      writeScale = false;
+    }
+  }
+
+  if (writePosition && writeRotation && localPosition == localRotation) {
+    if (localPosition) {
+      Transform_LocalPositionAndRotation(transform, *position, *rotation);
+    } else {
+      Transform_PositionAndRotation(transform, *position, *rotation);
+    }
+  } else {
+    if (writeRotation) {
+      if (localRotation) {
+        Transform_LocalRotation(transform, *rotation);
+      } else {
+        Transform_Rotation(transform, *rotation);
+      }
+    }
+    if (writePosition) {
+      if (localPosition) {
+        Transform_LocalPosition(transform, *position);
+      } else {
+        Transform_Position(transform, *position);
+      }
+    }
+  }
+  if (writeScale) {
+    Transform_Scale(transform, *scale);
+  }
+
+  return (writePosition ? WrotePosition : 0) | (writeRotation ? WroteRotation : 0) | (writeScale ? WroteScale : 0);
+}
+
+} // namespace Tracks
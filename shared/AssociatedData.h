@@ -11,6 +11,7 @@
 #include "Hash.h"
 #include "Vector.h"
 #include "bindings.h"
+#include "FfiAccounting.h"
 #include "binding_wrappers.hpp"
 
 #include "custom-json-data/shared/CustomBeatmapData.h"
@@ -31,6 +32,38 @@ using TracksVector = sbo::small_vector<TrackW, 1>;
 
 enum class EventType { unknown, animateTrack, assignPathAnimation };
 
+/// Entry count and estimated heap bytes of one store
+struct StoreStats {
+  size_t count = 0;
+  size_t bytes = 0;
+};
+
+/**
+ * @brief Estimated memory held for a beatmap, see BeatmapAssociatedData::GetMemoryStats.
+ * All byte counts are estimates: C++ containers are sized from sizeof and their capacity, Rust objects from fixed
+ * per point and per track sizes since the FFI does not expose allocation sizes.
+ */
+struct BeatmapMemoryStats {
+  StoreStats pointDefinitions;
+  StoreStats pointDefinitionAnonymous;
+  StoreStats pointDefinitionsJSON;
+  StoreStats tracks;
+  // shared by all beatmaps
+  StoreStats eventData;
+  StoreStats rustEventData;
+  // process wide and never freed
+  StoreStats convertedJson;
+
+  /// Held by this beatmap only
+  [[nodiscard]] size_t TotalBytes() const {
+    return pointDefinitions.bytes + pointDefinitionAnonymous.bytes + pointDefinitionsJSON.bytes + tracks.bytes;
+  }
+  /// Shared by every beatmap loaded so far, not part of TotalBytes
+  [[nodiscard]] size_t SharedBytes() const {
+    return eventData.bytes + rustEventData.bytes + convertedJson.bytes;
+  }
+};
+
 class BeatmapAssociatedData {
 public:
   BeatmapAssociatedData() {
@@ -47,6 +80,10 @@ public:
   bool leftHanded = false;
   bool v2;
 
+  /// Opt in, definitions handed out by getPointDefinition are baked into lookup tables where possible.
+  /// Event definitions are interpolated by tracks_rs and never baked
+  static inline std::optional<BakedPointDefinition::Options> bakeOnLoad;
+
   // custom hash and equality for pair to avoid specializing std::hash after instantiation
   struct PairHash {
     size_t operator()(std::pair<std::string, Tracks::ffi::WrapBaseValueType> const& pair) const noexcept {
@@ -67,6 +104,15 @@ public:
   std::unordered_map<std::string, rapidjson::Value const*, string_hash, string_equal> pointDefinitionsJSON;
   std::unordered_map<std::pair<std::string, Tracks::ffi::WrapBaseValueType>, PointDefinitionW, PairHash, PairEqual> pointDefinitions;
   std::vector<PointDefinitionW> pointDefinitionAnonymous;
+  // inline point data, identical inline arrays share one definition which this keeps alive
+  struct InlinePointDefinition {
+    // lives in the beatmap custom data, compared on a hash hit
+    rapidjson::Value const* json;
+    Tracks::ffi::WrapBaseValueType type;
+    PointDefinitionW pointDefinition;
+  };
+  // by CanonicalPointDataHash
+  std::unordered_multimap<uint64_t, InlinePointDefinition> pointDefinitionAnonymousLookup;
 
   /**
    * @brief Get the Point Definition object and adds to map if named
@@ -79,7 +125,8 @@ public:
   [[nodiscard]]
   PointDefinitionW getPointDefinition(rapidjson::Value const& customData, std::string_view customDataKey,
                                                        Tracks::ffi::WrapBaseValueType type) {
-    auto pointData = Animation::ParsePointData(*this, customData, customDataKey, type);
+    auto pointData =
+        Animation::ParsePointData(*this, customData, customDataKey, type, bakeOnLoad ? &*bakeOnLoad : nullptr);
 
     return pointData;
   }
@@ -115,11 +162,12 @@ public:
       return getTrack(*it);
     }
 
-    auto freeTrack = Tracks::ffi::track_create();
+    auto freeTrack = TRACKS_FFI(track_create)();
     auto trackKey = tracks_holder->AddTrack(freeTrack);
 
     auto ownedTrack = getTrack(trackKey);
     ownedTrack.SetName(name);
+    tracks_holder->RememberTrackKey(name, trackKey);
 
     return ownedTrack;
   }
@@ -136,6 +184,9 @@ public:
     return tracks_holder;
   }
 
+  /// Counts and estimated bytes of every store, walks all of them so don't call it per frame
+  [[nodiscard]] BeatmapMemoryStats GetMemoryStats() const;
+
 private:
   std::shared_ptr<TracksHolderW> tracks_holder;
   std::shared_ptr<BaseProviderContextW> base_provider_context;
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bindings.h"
+
+/**
+ * @brief Opt-in call counting for the tracks_rs boundary.
+ *
+ * Every Tracks::ffi function called from the wrappers goes through TRACKS_FFI(name)(args...).
+ * With TRACKS_FFI_ACCOUNTING each call is counted and timed per symbol, otherwise the macro is just Tracks::ffi::name.
+ */
+namespace Tracks::FfiAccounting {
+
+struct SymbolStats {
+  char const* name;
+  std::atomic<uint64_t> calls = 0;
+  std::atomic<uint64_t> ns = 0;
+};
+
+struct SymbolReport {
+  char const* name;
+  uint64_t calls;
+  uint64_t ns;
+};
+
+/// Stable for the lifetime of the process, one per symbol
+SymbolStats& Register(char const* name);
+
+/// Marks a frame boundary, logs a per frame report every reportInterval frames
+void EndFrame();
+
+/// Totals since the last reset, sorted by time spent
+std::vector<SymbolReport> Snapshot();
+uint64_t FrameCount();
+void Reset();
+
+inline constexpr uint64_t reportInterval = 900;
+
+template <auto fn> struct CountedCall {
+  SymbolStats& stats;
+
+  template <typename... TArgs> decltype(auto) operator()(TArgs&&... args) const {
+    struct Timer {
+      SymbolStats& stats;
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+      ~Timer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        stats.calls.fetch_add(1, std::memory_order_relaxed);
+        stats.ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                           std::memory_order_relaxed);
+      }
+    } timer{ stats };
+
+    return fn(std::forward<TArgs>(args)...);
+  }
+};
+
+template <auto fn> CountedCall<fn> Counted(char const* name) {
+  static SymbolStats& stats = Register(name);
+  return { stats };
+}
+
+} // namespace Tracks::FfiAccounting
+
+#ifdef TRACKS_FFI_ACCOUNTING
+#define TRACKS_FFI(fn) (::Tracks::FfiAccounting::Counted<&::Tracks::ffi::fn>(#fn))
+#else
+#define TRACKS_FFI(fn) ::Tracks::ffi::fn
+#endif
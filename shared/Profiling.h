@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Scoped timers for the per frame and load stages, exported as Chrome trace JSON (chrome://tracing, Perfetto).
+ *
+ * Zones are only compiled in with TRACKS_PROFILING, otherwise TRACKS_PROFILE_ZONE expands to nothing.
+ * Every thread writes into its own fixed size ring buffer, oldest zones get overwritten once it is full.
+ */
+namespace Tracks::Profiling {
+
+struct ZoneRecord {
+  // must have static storage duration, zones are named with string literals
+  char const* name;
+  int64_t startNs;
+  int64_t endNs;
+};
+
+inline int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Submit(ZoneRecord const& record);
+
+/// Writes every thread's zones to path as Chrome trace JSON and clears them. Returns false if the file failed to open
+bool DumpChromeTrace(std::string_view path);
+
+/// Drops all recorded zones
+void Clear();
+
+class Zone {
+public:
+  explicit Zone(char const* name) : name(name), startNs(Now()) {}
+  Zone(Zone const&) = delete;
+
+  ~Zone() {
+    Submit({ name, startNs, Now() });
+  }
+
+private:
+  char const* name;
+  int64_t startNs;
+};
+
+} // namespace Tracks::Profiling
+
+#define TRACKS_PROFILE_CONCAT_INNER(a, b) a##b
+#define TRACKS_PROFILE_CONCAT(a, b) TRACKS_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef TRACKS_PROFILING
+#define TRACKS_PROFILE_ZONE(name) Tracks::Profiling::Zone TRACKS_PROFILE_CONCAT(tracksProfileZone, __LINE__)(name)
+#else
+#define TRACKS_PROFILE_ZONE(name) ((void)0)
+#endif
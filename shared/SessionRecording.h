@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bindings.h"
+
+namespace CustomJSONData {
+class CustomBeatmapData;
+class CustomEventData;
+} // namespace CustomJSONData
+
+/**
+ * @brief Per frame coroutine inputs of a play session, recorded on device and replayed on host.
+ *
+ * A session file is a header followed by tagged records, all little endian:
+ *   header:  u32 magic, u16 version, u8 v2
+ *   beatmap: the point definitions of the beatmap custom data as JSON
+ *   event:   u32 index, type, time, JSON data. Written the first time the event fires
+ *   baseKey: u16 index, name of a base provider value
+ *   frame:   song time, changed base provider values, fired events (index, bpm, song time)
+ * Strings are a u32 length followed by the bytes.
+ *
+ * Recording is compiled in with TRACKS_SESSION_RECORDING, the reader is always available.
+ */
+namespace Tracks::SessionRecording {
+
+inline constexpr uint32_t magic = 0x534B5254; // "TRKS"
+inline constexpr uint16_t version = 1;
+
+enum class RecordTag : uint8_t { Beatmap = 1, Event = 2, BaseKey = 3, Frame = 4 };
+
+struct RecordedEvent {
+  std::string type;
+  float time;
+  std::string json;
+};
+
+struct BaseValueChange {
+  uint16_t key;
+  Tracks::ffi::WrapBaseValue value;
+};
+
+struct FiredEvent {
+  uint32_t event;
+  float bpm;
+  float songTime;
+};
+
+struct RecordedFrame {
+  float songTime;
+  std::vector<BaseValueChange> baseValues;
+  std::vector<FiredEvent> firedEvents;
+};
+
+struct Session {
+  bool v2 = false;
+  // {"pointDefinitions": ...} or its v2 equivalent
+  std::string beatmapJson;
+  std::vector<RecordedEvent> events;
+  std::vector<std::string> baseKeys;
+  std::vector<RecordedFrame> frames;
+};
+
+/// Starts a new recording in directory, ends the previous one
+void Begin(CustomJSONData::CustomBeatmapData* beatmapData, std::string_view directory);
+void End();
+bool IsRecording();
+
+void RecordEventFired(CustomJSONData::CustomEventData const* customEventData, float bpm, float songTime);
+/// Remembered while not recording too, so values set before the first frame still make it into the file
+void RecordBaseValue(std::string_view key, Tracks::ffi::WrapBaseValue const& value);
+/// Flushes everything recorded since the last frame, call right before coroutines are polled
+void RecordFrame(float songTime);
+
+/// Reads a whole session file, throws std::runtime_error on malformed input
+inline Session ReadSession(std::string const& path) {
+  std::unique_ptr<FILE, decltype(&std::fclose)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+  if (!file) {
+    throw std::runtime_error("Could not open session " + path);
+  }
+
+  auto read = [&](void* data, size_t size) {
+    if (std::fread(data, 1, size, file.get()) != size) {
+      throw std::runtime_error("Truncated session " + path);
+    }
+  };
+  auto readValue = [&]<typename T>(T& value) { read(&value, sizeof(T)); };
+  auto readString = [&](std::string& str) {
+    uint32_t length;
+    readValue(length);
+    str.resize(length);
+    if (length > 0) read(str.data(), length);
+  };
+
+  uint32_t fileMagic;
+  uint16_t fileVersion;
+  uint8_t v2;
+  readValue(fileMagic);
+  readValue(fileVersion);
+  readValue(v2);
+  if (fileMagic != magic || fileVersion != version) {
+    throw std::runtime_error("Not a session file or unsupported version " + path);
+  }
+
+  Session session;
+  session.v2 = v2 != 0;
+
+  RecordTag tag;
+  while (std::fread(&tag, sizeof(tag), 1, file.get()) == 1) {
+    switch (tag) {
+    case RecordTag::Beatmap:
+      readString(session.beatmapJson);
+      break;
+    case RecordTag::Event: {
+      uint32_t index;
+      readValue(index);
+      if (index >= session.events.size()) session.events.resize(index + 1);
+      auto& event = session.events[index];
+      readString(event.type);
+      readValue(event.time);
+      readString(event.json);
+      break;
+    }
+    case RecordTag::BaseKey: {
+      uint16_t index;
+      readValue(index);
+      if (index >= session.baseKeys.size()) session.baseKeys.resize(index + 1);
+      readString(session.baseKeys[index]);
+      break;
+    }
+    case RecordTag::Frame: {
+      auto& frame = session.frames.emplace_back();
+      uint16_t baseCount;
+      uint16_t firedCount;
+      readValue(frame.songTime);
+      readValue(baseCount);
+      frame.baseValues.resize(baseCount);
+      for (auto& change : frame.baseValues) {
+        readValue(change.key);
+        readValue(change.value);
+      }
+      readValue(firedCount);
+      frame.firedEvents.resize(firedCount);
+      for (auto& fired : frame.firedEvents) {
+        readValue(fired);
+      }
+      break;
+    }
+    default:
+      throw std::runtime_error("Unknown record in session " + path);
+    }
+  }
+
+  return session;
+}
+
+} // namespace Tracks::SessionRecording
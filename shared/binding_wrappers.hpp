@@ -2,29 +2,72 @@
 
 #include "Vector.h"
 #include "bindings.h"
+#include "FfiAccounting.h"
+#include "Hash.h"
 
+#ifdef TRACKS_SESSION_RECORDING
+#include "SessionRecording.h"
+#endif
+
+#include <array>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 
 namespace TracksAD {
+/// Change counter for the transform properties of one track, shared by every TrackW with the same key
+struct TrackTransformState {
+  // position, localPosition, rotation, localRotation, scale
+  static constexpr size_t propertyCount = 5;
+
+  uint64_t generation = 0;
+  // TracksHolderW::writeEpoch the stamps were last checked at
+  uint64_t checkedEpoch = 0;
+  // tracks_rs stamps as last seen, only ever compared for equality
+  std::array<Tracks::ffi::CTimeUnit, propertyCount> stamps{};
+  // TracksHolderW::writeEpoch each property was first seen written at
+  std::array<uint64_t, propertyCount> changedEpochs{};
+  // values read along with the stamps, snapshots in the same epoch are built from these
+  std::array<Tracks::ffi::CValueNullable, propertyCount> values{};
+};
+
 class TracksHolderW {
 public:
   Tracks::ffi::TracksHolder* internal_tracks_context = nullptr;
+  /// Bumped whenever tracks_rs may have moved its tracks, Track pointers resolved before a bump are stale
+  uint64_t generation = 1;
+  /// Bumped once per frame by the poll and by C++ writes outside the coroutines, see MarkWritten. Each frame re-checks
+  /// the stamps of the tracks in use, so writes nobody marked still show up by the next frame
+  uint64_t writeEpoch = 1;
+  // node based so TrackW can keep pointers into it
+  std::unordered_map<uint64_t, TrackTransformState> transformStates;
+  /// Name to key of every track looked up or added so far, keys never change once a track is in the holder.
+  /// Renames go through TrackW::SetName, which keeps this up to date
+  std::unordered_map<std::string, Tracks::ffi::TrackKeyFFI, TracksAD::string_hash, TracksAD::string_equal> trackKeys;
 
   TracksHolderW() {
-    internal_tracks_context = Tracks::ffi::tracks_holder_create();
+    internal_tracks_context = TRACKS_FFI(tracks_holder_create)();
   }
   TracksHolderW(TracksHolderW const&) = delete;
 
-  TracksHolderW(TracksHolderW&& o) noexcept : internal_tracks_context(o.internal_tracks_context) {
+  /// Call after writing track properties outside of the coroutines, e.g. through the raw FFI, so the write is seen
+  /// within the same frame
+  void MarkWritten() {
+    writeEpoch++;
+  }
+
+  TracksHolderW(TracksHolderW&& o) noexcept
+      : internal_tracks_context(o.internal_tracks_context), generation(o.generation), writeEpoch(o.writeEpoch),
+        transformStates(std::move(o.transformStates)), trackKeys(std::move(o.trackKeys)) {
     o.internal_tracks_context = nullptr;
   }
   ~TracksHolderW() {
     if (!internal_tracks_context) {
       return;
     }
-    Tracks::ffi::tracks_holder_destroy(internal_tracks_context);
+    TRACKS_FFI(tracks_holder_destroy)(internal_tracks_context);
   }
 
   operator Tracks::ffi::TracksHolder const*() const {
@@ -35,11 +78,13 @@ public:
   }
 
   [[nodiscard]]
-  Tracks::ffi::TrackKeyFFI AddTrack(Tracks::ffi::Track* track) const {
+  Tracks::ffi::TrackKeyFFI AddTrack(Tracks::ffi::Track* track) {
     if (!internal_tracks_context) {
       throw std::runtime_error("TracksContext is null");
     }
-    auto ptr = Tracks::ffi::tracks_holder_add_track(internal_tracks_context, track);
+    auto ptr = TRACKS_FFI(tracks_holder_add_track)(internal_tracks_context, track);
+    // the holder's storage may have grown and moved every track
+    generation++;
 
     return ptr;
   }
@@ -49,26 +94,51 @@ public:
     if (!internal_tracks_context) {
       throw std::runtime_error("TracksContext is null");
     }
-    auto track = Tracks::ffi::tracks_holder_get_track_mut(internal_tracks_context, index);
+    auto track = TRACKS_FFI(tracks_holder_get_track_mut)(internal_tracks_context, index);
     return track;
   }
 
+  /// Only asks tracks_rs the first time a name is seen
   [[nodiscard]]
-  std::optional<Tracks::ffi::TrackKeyFFI> GetTrackKey(std::string_view name) const {
+  std::optional<Tracks::ffi::TrackKeyFFI> GetTrackKey(std::string_view name) {
     if (!internal_tracks_context) {
       throw std::runtime_error("TracksContext is null");
     }
-    auto key = Tracks::ffi::tracks_holder_get_track_key(internal_tracks_context, name.data());
+    auto it = trackKeys.find(name);
+    if (it != trackKeys.end()) {
+      return it->second;
+    }
+
+    // the view might not be NUL terminated
+    std::string ownedName(name);
+    auto key = TRACKS_FFI(tracks_holder_get_track_key)(internal_tracks_context, ownedName.c_str());
     if (key._0 == -1) return std::nullopt;
+    trackKeys.emplace(std::move(ownedName), key);
     return key;
   }
+
+  /// For tracks added and named after the fact, so GetTrackKey finds them without asking tracks_rs
+  void RememberTrackKey(std::string_view name, Tracks::ffi::TrackKeyFFI key) {
+    trackKeys.insert_or_assign(std::string(name), key);
+  }
+
+  /// Drops every name remembered for key and remembers name instead, renames are rare so this walks the cache
+  void RenameTrackKey(Tracks::ffi::TrackKeyFFI key, std::string_view name) {
+    std::erase_if(trackKeys, [key](auto const& entry) { return entry.second._0 == key._0; });
+    RememberTrackKey(name, key);
+  }
+
+  [[nodiscard]]
+  TrackTransformState& GetTransformState(Tracks::ffi::TrackKeyFFI const& index) {
+    return transformStates[index._0];
+  }
 };
 
 struct BaseProviderContextW {
   Tracks::ffi::BaseProviderContext* internal_base_provider_context;
 
   BaseProviderContextW() {
-    internal_base_provider_context = Tracks::ffi::base_provider_context_create();
+    internal_base_provider_context = TRACKS_FFI(base_provider_context_create)();
   }
   BaseProviderContextW(Tracks::ffi::BaseProviderContext* context) : internal_base_provider_context(context){};
   BaseProviderContextW(BaseProviderContextW const&) = delete;
@@ -86,22 +156,25 @@ struct BaseProviderContextW {
 
   ~BaseProviderContextW() {
     if (internal_base_provider_context) {
-      Tracks::ffi::base_provider_context_destroy(internal_base_provider_context);
+      TRACKS_FFI(base_provider_context_destroy)(internal_base_provider_context);
     }
   }
 
   Tracks::ffi::WrapBaseValueType GetType(std::string_view key) const {
-    return Tracks::ffi::base_provider_context_get_type(internal_base_provider_context, key.data());
+    return TRACKS_FFI(base_provider_context_get_type)(internal_base_provider_context, key.data());
   }
 
   [[nodiscard]]
   Tracks::ffi::WrapBaseValue GetBaseValue(std::string_view key) const {
-    return Tracks::ffi::base_provider_context_get_value(internal_base_provider_context, key.data());
+    return TRACKS_FFI(base_provider_context_get_value)(internal_base_provider_context, key.data());
   }
 
 
   void SetBaseValue(std::string_view key, Tracks::ffi::WrapBaseValue const& value) {
-    Tracks::ffi::base_provider_context_set_value(internal_base_provider_context, key.data(), value);
+#ifdef TRACKS_SESSION_RECORDING
+    Tracks::SessionRecording::RecordBaseValue(key, value);
+#endif
+    TRACKS_FFI(base_provider_context_set_value)(internal_base_provider_context, key.data(), value);
   }
 
   float GetFloatValue(std::string_view key) const {
@@ -188,7 +261,7 @@ struct EventDataW {
 
   ~EventDataW() {
     if (internal_event_data) {
-      Tracks::ffi::event_data_dispose(internal_event_data);
+      TRACKS_FFI(event_data_dispose)(internal_event_data);
     }
   }
 };
@@ -197,7 +270,7 @@ struct CoroutineManagerW {
   Tracks::ffi::CoroutineManager* internal_coroutine;
 
   CoroutineManagerW() {
-    internal_coroutine = Tracks::ffi::create_coroutine_manager();
+    internal_coroutine = TRACKS_FFI(create_coroutine_manager)();
   }
   CoroutineManagerW(Tracks::ffi::CoroutineManager* coroutine) : internal_coroutine(coroutine) {};
   CoroutineManagerW(CoroutineManagerW const&) = delete;
@@ -215,19 +288,20 @@ struct CoroutineManagerW {
 
   ~CoroutineManagerW() {
     if (internal_coroutine) {
-      Tracks::ffi::destroy_coroutine_manager(internal_coroutine);
+      TRACKS_FFI(destroy_coroutine_manager)(internal_coroutine);
     }
   }
 
   void StartCoroutine(float bpm, float songTime, BaseProviderContextW const& context, TracksHolderW& tracksHolder,
                       EventDataW const& eventData) {
-    Tracks::ffi::start_event_coroutine(internal_coroutine, bpm, songTime, context.internal_base_provider_context,
-                                       tracksHolder, eventData.internal_event_data);
+    TRACKS_FFI(start_event_coroutine)(internal_coroutine, bpm, songTime, context.internal_base_provider_context,
+                                      tracksHolder, eventData.internal_event_data);
+    // picked up by the bump of the next poll, starting events does not advance the epoch
   }
 
   void PollCoroutines(float songTime, BaseProviderContextW const& context, TracksHolderW& tracksHolder) {
-    Tracks::ffi::poll_events(internal_coroutine, songTime, context.internal_base_provider_context,
-                             tracksHolder);
+    TRACKS_FFI(poll_events)(internal_coroutine, songTime, context.internal_base_provider_context, tracksHolder);
+    tracksHolder.MarkWritten();
   }
 };
 } // namespace TracksAD
\ No newline at end of file
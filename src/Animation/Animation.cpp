@@ -10,8 +10,14 @@ namespace Animation {
 
 /// Try to get point definition from beatmap associated data
 PointDefinitionW ParsePointData(BeatmapAssociatedData& beatmapAD, rapidjson::Value const& customData,
-                                std::string_view customDataKey, Tracks::ffi::WrapBaseValueType type) {
+                                std::string_view customDataKey, Tracks::ffi::WrapBaseValueType type,
+                                BakedPointDefinition::Options const* bake) {
   PointDefinitionW pointData = PointDefinitionW(nullptr);
+  // baked where it is stored, so every later lookup shares the table
+  auto bakeStored = [bake](PointDefinitionW& stored) {
+    if (bake && stored) stored.Bake(*bake);
+    return stored;
+  };
 
   auto customDataItr = customData.FindMember(customDataKey.data());
   if (customDataItr == customData.MemberEnd()) {
@@ -30,7 +36,7 @@ PointDefinitionW ParsePointData(BeatmapAssociatedData& beatmapAD, rapidjson::Val
     auto keyPair = std::pair<std::string, Tracks::ffi::WrapBaseValueType>(std::string(id), type);
     auto it = beatmapAD.pointDefinitions.find(keyPair);
     if (it != beatmapAD.pointDefinitions.end()) {
-      return it->second;
+      return bakeStored(it->second);
     }
 
     auto itr = beatmapAD.pointDefinitionsJSON.find(id);
@@ -43,15 +49,30 @@ PointDefinitionW ParsePointData(BeatmapAssociatedData& beatmapAD, rapidjson::Val
     TLogger::Logger.fmtLog<Paper::LogLevel::INF>("Using point definition {} {}", pointString.GetString(), (int)type);
     auto baseProviderContext = beatmapAD.GetBaseProviderContext();
     pointData = PointDefinitionW(*itr->second, type, baseProviderContext);
+    bakeStored(pointData);
     beatmapAD.AddPointDefinition(id, pointData);
 
     break;
   }
     // is a point object, parse
   default:
+    // scripted maps repeat the same inline arrays many times, parse each one once
+    auto hash = CanonicalPointDataHash(pointString);
+    auto [begin, end] = beatmapAD.pointDefinitionAnonymousLookup.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      if (it->second.type == type && *it->second.json == pointString) {
+        return bakeStored(it->second.pointDefinition);
+      }
+    }
+
     auto baseProviderContext = beatmapAD.GetBaseProviderContext();
     pointData = PointDefinitionW(pointString, type, baseProviderContext);
-    beatmapAD.AddPointDefinition(std::nullopt, pointData);
+    bakeStored(pointData);
+    beatmapAD.pointDefinitionAnonymousLookup.emplace(hash, BeatmapAssociatedData::InlinePointDefinition{
+                                                               .json = &pointString,
+                                                               .type = type,
+                                                               .pointDefinition = pointData,
+                                                           });
   }
 
   return pointData;
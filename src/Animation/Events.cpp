@@ -18,11 +18,17 @@
 #include "Animation/Easings.h"
 #include "Animation/Track.h"
 #include "Animation/Animation.h"
+#include "Animation/GameObjectTrackSystem.hpp"
 #include "TimeSourceHelper.h"
 #include "AssociatedData.h"
 #include "TLogger.h"
 #include "Vector.h"
 #include "StaticHolders.hpp"
+#include "Profiling.h"
+
+#ifdef TRACKS_SESSION_RECORDING
+#include "SessionRecording.h"
+#endif
 
 using namespace Events;
 using namespace GlobalNamespace;
@@ -39,6 +45,7 @@ MAKE_HOOK_MATCH(BeatmapObjectSpawnController_Start, &BeatmapObjectSpawnControlle
 }
 
 void Events::UpdateCoroutines(BeatmapCallbacksController* callbackController) {
+  TRACKS_PROFILE_ZONE("Events::UpdateCoroutines");
   auto songTime = callbackController->songTime;
   auto customBeatmapData = il2cpp_utils::cast<CustomJSONData::CustomBeatmapData>(callbackController->_beatmapData);
 
@@ -47,11 +54,19 @@ void Events::UpdateCoroutines(BeatmapCallbacksController* callbackController) {
   auto coroutine = beatmapAD.GetCoroutineManager();
   auto baseManager = beatmapAD.GetBaseProviderContext();
   auto tracksHolder = beatmapAD.GetTracksHolder();
+#ifdef TRACKS_SESSION_RECORDING
+  Tracks::SessionRecording::RecordFrame(songTime);
+#endif
+#ifdef TRACKS_FFI_ACCOUNTING
+  Tracks::FfiAccounting::EndFrame();
+#endif
   coroutine->PollCoroutines(songTime, *baseManager, *tracksHolder);
+  Tracks::GameObjectTrackSystem::UpdateAll();
 }
 
 void CustomEventCallback(BeatmapCallbacksController* callbackController,
                          CustomJSONData::CustomEventData* customEventData) {
+  TRACKS_PROFILE_ZONE("CustomEventCallback");
 
   bool isType = false;
 
@@ -101,6 +116,10 @@ void CustomEventCallback(BeatmapCallbacksController* callbackController,
 
   auto songTime = callbackController->_songTime;
 
+#ifdef TRACKS_SESSION_RECORDING
+  Tracks::SessionRecording::RecordEventFired(customEventData, bpm, songTime);
+#endif
+
   for (auto const& event : eventAD.rustEventData) {
     coroutineManager->StartCoroutine(bpm, songTime, *baseManager, *tracksHolder, *event);
   }
@@ -1,11 +1,8 @@
 #include "Animation/GameObjectTrackController.hpp"
+#include "Animation/GameObjectTrackSystem.hpp"
 
-#include "Animation/Animation.h"
 #include "TLogger.h"
 
-#include "sombrero/shared/Vector3Utils.hpp"
-#include "sombrero/shared/QuaternionUtils.hpp"
-
 using namespace Tracks;
 
 bool GameObjectTrackController::LeftHanded = false;
@@ -20,6 +17,12 @@ using namespace Tracks;
 //          return {conj.x / norm2, conj.y / norm2, conj.z / norm2,
 //                            conj.w / norm2};
 // }
+void GameObjectTrackControllerData::SetTracks(std::span<TrackW const> track, bool v2) {
+  _track.assign(track.begin(), track.end());
+  this->v2 = v2;
+  if (owner) GameObjectTrackSystem::Refresh(owner);
+}
+
 GameObjectTrackControllerData& GameObjectTrackController::getTrackControllerData() {
   return *data;
 }
@@ -30,18 +33,20 @@ void GameObjectTrackController::ClearData() {
 
 void GameObjectTrackController::Awake() {
   attemptedTries = 0;
+  systemIndex = GameObjectTrackSystem::unregistered;
 
   // OnTransformParentChanged();
 }
 
 void GameObjectTrackController::Start() {
   CJDLogger::Logger.fmtLog<Paper::LogLevel::INF>("Checking data {} v2 {}", fmt::ptr(data), data ? data->v2 : false);
-  lastCheckedTime = TimeUnit();
+  GameObjectTrackSystem::Refresh(this);
 
   // CRASH_UNLESS(data);
 }
 
 void GameObjectTrackController::OnDestroy() {
+  GameObjectTrackSystem::Unregister(this);
   if (data == nullptr) {
     return;
   }
@@ -51,21 +56,32 @@ void GameObjectTrackController::OnDestroy() {
 }
 
 void GameObjectTrackController::OnEnable() {
+  GameObjectTrackSystem::Register(this);
   OnTransformParentChanged();
 }
 
+void GameObjectTrackController::OnDisable() {
+  GameObjectTrackSystem::Unregister(this);
+}
+
 void GameObjectTrackController::OnTransformParentChanged() {
   origin = get_transform();
   parent = origin->get_parent();
   CJDLogger::Logger.fmtLog<Paper::LogLevel::ERR>("Parent changed {}", static_cast<std::string>(this->get_name()));
+  GameObjectTrackSystem::Refresh(this);
   UpdateData(true);
 }
 
-void GameObjectTrackController::Update() {
-  UpdateData(false);
+void GameObjectTrackController::UpdateData(bool force) {
+  if (systemIndex == GameObjectTrackSystem::unregistered) {
+    // disabled, OnEnable forces an update anyway
+    if (!data) HandleMissingTracks();
+    return;
+  }
+  GameObjectTrackSystem::Update(systemIndex, force);
 }
 
-void GameObjectTrackController::UpdateData(bool force) {
+void GameObjectTrackController::HandleMissingTracks() {
   if (!data) {
 
     // Wait once just in case
@@ -87,103 +103,10 @@ void GameObjectTrackController::UpdateData(bool force) {
     return;
   }
 
-  auto const _noteLinesDistance = 0.6f; // StaticBeatmapObjectSpawnMovementData.kNoteLinesDistance
-  auto const& tracks = data->_track;
-
-  if (tracks.empty()) {
-    CJDLogger::Logger.fmtLog<Paper::LogLevel::ERR>("Track is null! Should remove component or just early return? {} {}",
-                                                   fmt::ptr(this),
-                                                   static_cast<std::string>(get_gameObject()->get_name()));
-    Destroy(this);
-    return;
-  }
-  if (force) {
-    lastCheckedTime = TimeUnit();
-  }
-
-  std::optional<NEVector::Quaternion> rotation;
-  std::optional<NEVector::Quaternion> localRotation;
-  std::optional<NEVector::Vector3> position;
-  std::optional<NEVector::Vector3> localPosition;
-  std::optional<NEVector::Vector3> scale;
-
-  if (tracks.size() == 1) {
-    auto track = tracks.front();
-    CRASH_UNLESS(track);
-    CRASH_UNLESS(track.getTrackPtr());
-
-    // after
-    rotation = track.GetPropertyNamed(PropertyNames::Rotation).GetQuat(lastCheckedTime);
-    localRotation = track.GetPropertyNamed(PropertyNames::LocalRotation).GetQuat(lastCheckedTime);
-    position = track.GetPropertyNamed(PropertyNames::Position).GetVec3(lastCheckedTime);
-    localPosition = track.GetPropertyNamed(PropertyNames::LocalPosition).GetVec3(lastCheckedTime);
-    scale = track.GetPropertyNamed(PropertyNames::Scale).GetVec3(lastCheckedTime);
-
-  } else {
-
-    // now
-    auto localRotations = Animation::getPropertiesQuat(tracks, PropertyNames::LocalRotation, lastCheckedTime);
-    auto rotations = Animation::getPropertiesQuat(tracks, PropertyNames::Rotation, lastCheckedTime);
-    auto positions = Animation::getPropertiesVec3(tracks, PropertyNames::Position, lastCheckedTime);
-    auto localPositions = Animation::getPropertiesVec3(tracks, PropertyNames::LocalPosition, lastCheckedTime);
-    auto scales = Animation::getPropertiesVec3(tracks, PropertyNames::Scale, lastCheckedTime);
-
-    TRACKS_LIST_OPERATE_MULTIPLE(localRotation, localRotations, *);
-    TRACKS_LIST_OPERATE_MULTIPLE(rotation, rotations, *);
-    TRACKS_LIST_OPERATE_MULTIPLE(scale, scales, *);
-    TRACKS_LIST_OPERATE_MULTIPLE(position, positions, +);
-    TRACKS_LIST_OPERATE_MULTIPLE(localPosition, localPositions, +);
-  }
-
-  if (GameObjectTrackController::LeftHanded) {
-    localPosition = Animation::MirrorVectorNullable(localPosition);
-    position = Animation::MirrorVectorNullable(position);
-
-    rotation = Animation::MirrorQuaternionNullable(rotation);
-    localRotation = Animation::MirrorQuaternionNullable(localRotation);
-  }
-
-  auto transform = origin;
-
-  static auto Transform_Position =
-      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_position>::get();
-  static auto Transform_LocalPosition =
-      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_localPosition>::get();
-  static auto Transform_Rotation =
-      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_rotation>::get();
-  static auto Transform_LocalRotation =
-      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_localRotation>::get();
-  static auto Transform_Scale =
-      il2cpp_utils::il2cpp_type_check::FPtrWrapper<&UnityEngine::Transform::set_localScale>::get();
-  if (localRotation) {
-    Transform_LocalRotation(transform, localRotation.value());
-    data->RotationUpdate.invoke();
-  } else if (rotation) {
-    Transform_Rotation(transform, rotation.value());
-    data->RotationUpdate.invoke();
-  }
-
-  if (localPosition) {
-    if (data->v2) {
-      *localPosition *= _noteLinesDistance;
-    }
-    Transform_LocalPosition(transform, *localPosition);
-    data->PositionUpdate.invoke();
-  } else if (position) {
-    if (data->v2) {
-      *position *= _noteLinesDistance;
-    }
-
-    Transform_Position(transform, *position);
-    data->PositionUpdate.invoke();
-  }
-
-  if (scale) {
-    Transform_Scale(transform, scale.value());
-    data->ScaleUpdate.invoke();
-  }
-
-  lastCheckedTime = Animation::getCurrentTime();
+  CJDLogger::Logger.fmtLog<Paper::LogLevel::ERR>("Track is null! Should remove component or just early return? {} {}",
+                                                 fmt::ptr(this),
+                                                 static_cast<std::string>(get_gameObject()->get_name()));
+  Destroy(this);
 }
 
 std::optional<GameObjectTrackController*>
@@ -195,8 +118,7 @@ GameObjectTrackController::HandleTrackData(UnityEngine::GameObject* gameObject,
     if (overwrite) {
       CJDLogger::Logger.fmtLog<Paper::LogLevel::INF>("Overwriting existing TransformController on {}...",
                                                      std::string(gameObject->get_name()));
-      existingTrackController->data->_track = std::vector(track.begin(), track.end());
-      existingTrackController->data->v2 = v2;
+      existingTrackController->data->SetTracks(track, v2);
     } else {
       CJDLogger::Logger.fmtLog<Paper::LogLevel::INF>("Could not create TransformController, {} already has one.",
                                                      std::string(gameObject->get_name()));
@@ -214,6 +136,9 @@ GameObjectTrackController::HandleTrackData(UnityEngine::GameObject* gameObject,
                                                  static_cast<std::string>(gameObject->get_name()));
   // cleaned up on OnDestroy
   trackController->data = new GameObjectTrackControllerData(track, v2);
+  trackController->data->owner = trackController;
+  // Unity already ran OnEnable inside AddComponent, before the data was there
+  GameObjectTrackSystem::Refresh(trackController);
 
   // not necessary 
   // for (auto t : track) {
@@ -0,0 +1,319 @@
+#include "Animation/GameObjectTrackSystem.hpp"
+#include "Animation/GameObjectTrackController.hpp"
+
+#include "Animation/Animation.h"
+#include "TLogger.h"
+#include "Profiling.h"
+
+#include "sombrero/shared/Vector3Utils.hpp"
+#include "sombrero/shared/QuaternionUtils.hpp"
+
+using namespace Tracks;
+
+// no sum of track generations, forces the next combine
+static constexpr uint64_t unknownTransformGeneration = -1;
+// CompositeTrack::version no composite has, forces an update from the full current values
+static constexpr uint64_t needsFullUpdate = -1;
+
+std::vector<GameObjectTrackController*> GameObjectTrackSystem::controllers;
+std::vector<UnityEngine::Transform*> GameObjectTrackSystem::origins;
+std::vector<uint8_t> GameObjectTrackSystem::v2;
+std::vector<uint32_t> GameObjectTrackSystem::compositeIndices;
+std::vector<uint64_t> GameObjectTrackSystem::appliedVersions;
+std::vector<CompositeTrack> GameObjectTrackSystem::composites;
+std::vector<uint32_t> GameObjectTrackSystem::freeComposites;
+std::unordered_map<std::vector<uint64_t>, uint32_t, GameObjectTrackSystem::KeyListHash>
+    GameObjectTrackSystem::compositeLookup;
+
+CompositeTransform CompositeTransform::Combine(std::span<TrackW const> tracks, uint64_t lastCheckedEpoch) {
+  CompositeTransform combined;
+
+  // folded in place, sums for positions and products for rotations and scales. A single track is taken as is
+  auto fold = [&combined](std::optional<NEVector::Vector3> const& position,
+                          std::optional<NEVector::Vector3> const& localPosition,
+                          std::optional<NEVector::Quaternion> const& rotation,
+                          std::optional<NEVector::Quaternion> const& localRotation,
+                          std::optional<NEVector::Vector3> const& scale) {
+    if (localRotation) {
+      TRACKS_FOLD_OPERATE(combined.localRotation, *localRotation, *);
+    }
+    if (rotation) {
+      TRACKS_FOLD_OPERATE(combined.rotation, *rotation, *);
+    }
+    if (scale) {
+      TRACKS_FOLD_OPERATE(combined.scale, *scale, *);
+    }
+    if (position) {
+      TRACKS_FOLD_OPERATE(combined.position, *position, +);
+    }
+    if (localPosition) {
+      TRACKS_FOLD_OPERATE(combined.localPosition, *localPosition, +);
+    }
+  };
+
+  for (auto const& track : tracks) {
+    CRASH_UNLESS(track);
+    CRASH_UNLESS(track.getTrackPtr());
+
+    if (lastCheckedEpoch == 0) {
+      // no stamps needed, one track_get_properties_values call instead of a read per property
+      auto values = track.GetPropertiesValuesW();
+      fold(values.position, values.localPosition, values.rotation, values.localRotation, values.scale);
+      continue;
+    }
+
+    auto snapshot = track.GetTransformSnapshot();
+    fold(snapshot.position.Since(lastCheckedEpoch), snapshot.localPosition.Since(lastCheckedEpoch),
+         snapshot.rotation.Since(lastCheckedEpoch), snapshot.localRotation.Since(lastCheckedEpoch),
+         snapshot.scale.Since(lastCheckedEpoch));
+  }
+  return combined;
+}
+
+size_t GameObjectTrackSystem::KeyListHash::operator()(std::vector<uint64_t> const& keys) const noexcept {
+  size_t hash = keys.size();
+  for (auto key : keys) {
+    hash ^= std::hash<uint64_t>()(key) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+// track keys are only unique within their holder
+static std::vector<uint64_t> CompositeKey(std::span<TrackW const> trackList) {
+  std::vector<uint64_t> keys;
+  keys.reserve(trackList.size() + 1);
+  keys.push_back(reinterpret_cast<uintptr_t>(trackList.front().internal_tracks_context.get()));
+  for (auto const& track : trackList) {
+    keys.push_back(track.track._0);
+  }
+  return keys;
+}
+
+uint32_t GameObjectTrackSystem::AcquireComposite(std::span<TrackW const> trackList) {
+  auto keys = CompositeKey(trackList);
+
+  auto [it, inserted] = compositeLookup.try_emplace(std::move(keys), noComposite);
+  if (inserted) {
+    if (freeComposites.empty()) {
+      it->second = composites.size();
+      composites.emplace_back();
+    } else {
+      it->second = freeComposites.back();
+      freeComposites.pop_back();
+    }
+
+    auto& composite = composites[it->second];
+    composite = CompositeTrack();
+    composite.tracks.assign(trackList.begin(), trackList.end());
+    composite.lastTransformGeneration = unknownTransformGeneration;
+  }
+
+  composites[it->second].users++;
+  return it->second;
+}
+
+void GameObjectTrackSystem::ReleaseComposite(uint32_t index) {
+  if (index == noComposite) {
+    return;
+  }
+
+  auto& composite = composites[index];
+  if (--composite.users > 0) {
+    return;
+  }
+
+  compositeLookup.erase(CompositeKey(composite.tracks));
+  // drops the holder references
+  composite = CompositeTrack();
+  freeComposites.push_back(index);
+}
+
+CompositeTrack& GameObjectTrackSystem::EvaluateComposite(uint32_t index) {
+  auto& composite = composites[index];
+  // writeEpoch starts past the initial evaluatedEpoch, so new composites are combined right away
+  auto epoch = composite.tracks.front().internal_tracks_context->writeEpoch;
+  if (composite.evaluatedEpoch == epoch) {
+    return composite;
+  }
+  composite.evaluatedEpoch = epoch;
+
+  // generations only ever grow, so an unchanged sum means none of the tracks were written since the last combine
+  uint64_t transformGeneration = 0;
+  for (auto const& track : composite.tracks) {
+    transformGeneration += track.GetTransformGeneration();
+  }
+  if (transformGeneration == composite.lastTransformGeneration) {
+    return composite;
+  }
+  composite.lastTransformGeneration = transformGeneration;
+
+  composite.result = CompositeTransform::Combine(composite.tracks, composite.lastCheckedEpoch);
+  composite.lastCheckedEpoch = epoch;
+  composite.version++;
+  return composite;
+}
+
+// the index is only trusted if it points back at the controller, it is garbage before Awake and stale after Clear
+bool GameObjectTrackSystem::IsRegistered(GameObjectTrackController const* controller) {
+  auto index = controller->systemIndex;
+  return index < controllers.size() && controllers[index] == controller;
+}
+
+void GameObjectTrackSystem::Register(GameObjectTrackController* controller) {
+  if (IsRegistered(controller)) {
+    return;
+  }
+
+  controller->systemIndex = controllers.size();
+  controllers.push_back(controller);
+  origins.push_back(nullptr);
+  v2.push_back(false);
+  compositeIndices.push_back(noComposite);
+  appliedVersions.push_back(needsFullUpdate);
+  Refresh(controller);
+}
+
+void GameObjectTrackSystem::Unregister(GameObjectTrackController* controller) {
+  if (!IsRegistered(controller)) {
+    controller->systemIndex = unregistered;
+    return;
+  }
+  auto index = controller->systemIndex;
+  controller->systemIndex = unregistered;
+  ReleaseComposite(compositeIndices[index]);
+
+  auto last = controllers.size() - 1;
+  if (index != last) {
+    controllers[index] = controllers[last];
+    origins[index] = origins[last];
+    v2[index] = v2[last];
+    compositeIndices[index] = compositeIndices[last];
+    appliedVersions[index] = appliedVersions[last];
+    controllers[index]->systemIndex = index;
+  }
+
+  controllers.pop_back();
+  origins.pop_back();
+  v2.pop_back();
+  compositeIndices.pop_back();
+  appliedVersions.pop_back();
+}
+
+void GameObjectTrackSystem::Refresh(GameObjectTrackController* controller) {
+  if (!IsRegistered(controller)) {
+    return;
+  }
+
+  auto index = controller->systemIndex;
+  auto const* data = controller->data;
+  origins[index] = controller->origin;
+  v2[index] = data && data->v2;
+
+  // the composite keeps its own copy of the list, later changes come in through SetTracks or another Refresh
+  auto previous = compositeIndices[index];
+  compositeIndices[index] = data && !data->_track.empty() ? AcquireComposite(data->_track) : noComposite;
+  ReleaseComposite(previous);
+  appliedVersions[index] = needsFullUpdate;
+}
+
+void GameObjectTrackSystem::Update(size_t index, bool force) {
+  // same name as before the system, so traces still compare
+  TRACKS_PROFILE_ZONE("GameObjectTrackController::UpdateData");
+  if (compositeIndices[index] == noComposite) {
+    auto* controller = controllers[index];
+    auto const* data = controller->data;
+    if (!data || data->_track.empty()) {
+      controller->HandleMissingTracks();
+      return;
+    }
+
+    // the data showed up without a Refresh, e.g. it was assigned after OnEnable
+    Refresh(controller);
+  }
+
+  auto& composite = EvaluateComposite(compositeIndices[index]);
+  if (force || appliedVersions[index] == needsFullUpdate) {
+    // everything, not just what changed since the composite was last combined
+    appliedVersions[index] = composite.version;
+    Apply(index, CompositeTransform::Combine(composite.tracks, 0), true);
+    return;
+  }
+
+  if (appliedVersions[index] == composite.version) {
+    return;
+  }
+  // result only holds what changed since the previous version, a controller that missed it, e.g. skipped for a frame
+  // or combined twice in one, catches up from the full current values
+  bool missedVersion = appliedVersions[index] + 1 != composite.version;
+  appliedVersions[index] = composite.version;
+  Apply(index, missedVersion ? CompositeTransform::Combine(composite.tracks, 0) : composite.result, false);
+}
+
+void GameObjectTrackSystem::Apply(size_t index, CompositeTransform values, bool force) {
+  auto const _noteLinesDistance = 0.6f; // StaticBeatmapObjectSpawnMovementData.kNoteLinesDistance
+
+  auto& [position, localPosition, rotation, localRotation, scale] = values;
+
+  if (GameObjectTrackController::LeftHanded) {
+    localPosition = Animation::MirrorVectorNullable(localPosition);
+    position = Animation::MirrorVectorNullable(position);
+
+    rotation = Animation::MirrorQuaternionNullable(rotation);
+    localRotation = Animation::MirrorQuaternionNullable(localRotation);
+  }
+
+  // local wins over world, like Unity would if both were set one after another
+  bool useLocalPosition = localPosition.has_value();
+  bool useLocalRotation = localRotation.has_value();
+  auto& finalPosition = useLocalPosition ? localPosition : position;
+  auto& finalRotation = useLocalRotation ? localRotation : rotation;
+  if (finalPosition && v2[index]) {
+    *finalPosition *= _noteLinesDistance;
+  }
+
+  WriteTransform(origins[index], finalPosition, useLocalPosition, finalRotation, useLocalRotation, scale, !force);
+
+  // for every value the tracks updated, like before, even if the transform already held it
+  auto* data = controllers[index]->data;
+  if (finalRotation) {
+    data->RotationUpdate.invoke();
+  }
+  if (finalPosition) {
+    data->PositionUpdate.invoke();
+  }
+  if (scale) {
+    data->ScaleUpdate.invoke();
+  }
+}
+
+void GameObjectTrackSystem::UpdateAll() {
+  TRACKS_PROFILE_ZONE("GameObjectTrackSystem::UpdateAll");
+  // backwards, a controller destroying itself swaps an already updated one into its place
+  for (size_t i = controllers.size(); i-- > 0;) {
+    Update(i, false);
+  }
+}
+
+void GameObjectTrackSystem::Clear() {
+  for (auto* controller : controllers) {
+    controller->systemIndex = unregistered;
+  }
+
+  controllers.clear();
+  origins.clear();
+  v2.clear();
+  compositeIndices.clear();
+  appliedVersions.clear();
+
+  composites.clear();
+  freeComposites.clear();
+  compositeLookup.clear();
+}
+
+size_t GameObjectTrackSystem::Count() {
+  return controllers.size();
+}
+
+size_t GameObjectTrackSystem::CompositeCount() {
+  return compositeLookup.size();
+}
@@ -1,7 +1,12 @@
 #include "Animation/PointDefinition.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
 #include <utility>
 #include <numeric>
+#include <span>
 #include "Animation/Track.h"
 #include "Animation/Easings.h"
 #include "TLogger.h"
@@ -13,31 +18,424 @@ using namespace NEVector;
 
 
 
-// TODO: Make a recursive cleanup method
+// everything convert_rapidjson handed out so far, none of it is freed yet
+static std::atomic<size_t> convertedJsonNodes = 0;
+static std::atomic<size_t> convertedJsonBytes = 0;
+
+static void countConverted(size_t nodes, size_t bytes) {
+    convertedJsonNodes.fetch_add(nodes, std::memory_order_relaxed);
+    convertedJsonBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+ConvertRapidjsonStats GetConvertRapidjsonStats() {
+    return { convertedJsonNodes.load(std::memory_order_relaxed), convertedJsonBytes.load(std::memory_order_relaxed) };
+}
+
+namespace {
+// values below the root, and arrays, of a tree
+void countJson(rapidjson::Value const& value, size_t& values, size_t& arrays) {
+  if (!value.IsArray()) return;
+  arrays++;
+  values += value.Size();
+  for (auto const& element : value.GetArray()) {
+    countJson(element, values, arrays);
+  }
+}
+
+// hands out the slots of a buffer sized by countJson
+struct JsonBump {
+  Tracks::ffi::FFIJsonValue* values;
+  Tracks::ffi::JsonArray* arrays;
+
+  Tracks::ffi::FFIJsonValue* Values(size_t count) {
+    auto* run = values;
+    values += count;
+    return run;
+  }
+  Tracks::ffi::JsonArray* Array() {
+    return arrays++;
+  }
+};
+
+template <typename Bump> void fillJson(Tracks::ffi::FFIJsonValue& out, rapidjson::Value const& value, Bump& bump) {
+  if (value.IsNumber()) {
+    out = { Tracks::ffi::JsonValueType::Number, { .number_value = value.GetDouble() } };
+  } else if (value.IsNull()) {
+    out = { Tracks::ffi::JsonValueType::Null, {} };
+  } else if (value.IsString()) {
+    out = { Tracks::ffi::JsonValueType::String, { .string_value = value.GetString() } };
+  } else if (value.IsArray()) {
+    // elements are contiguous, their own arrays go after them
+    auto size = value.Size();
+    auto* elements = bump.Values(size);
+    for (size_t i = 0; i < size; i++) {
+      fillJson(elements[i], value[i], bump);
+    }
+
+    auto* jsonArray = bump.Array();
+    *jsonArray = { elements, size };
+    out = { Tracks::ffi::JsonValueType::Array, { .array = jsonArray } };
+  } else {
+    TLogger::Logger.error("Unsupported JSON value type in conversion");
+    // Return null as fallback
+    out = { Tracks::ffi::JsonValueType::Null, {} };
+  }
+}
+
+// bumped by JsonArena::ReleaseAll
+std::atomic<uint32_t> releaseRequests = 0;
+} // namespace
+
+ConvertedJson::ConvertedJson(rapidjson::Value const& value) {
+  size_t values = 1;
+  size_t arrays = 0;
+  countJson(value, values, arrays);
+
+  nodes = values;
+  bytes = values * sizeof(Tracks::ffi::FFIJsonValue) + arrays * sizeof(Tracks::ffi::JsonArray);
+  static_assert(sizeof(Tracks::ffi::FFIJsonValue) % alignof(Tracks::ffi::JsonArray) == 0);
+  storage = std::make_unique<std::byte[]>(bytes);
+
+  auto* root = reinterpret_cast<Tracks::ffi::FFIJsonValue*>(storage.get());
+  JsonBump bump{ root + 1, reinterpret_cast<Tracks::ffi::JsonArray*>(root + values) };
+  fillJson(*root, value, bump);
+}
+
+Tracks::ffi::FFIJsonValue const* ConvertedJson::Release() {
+  auto* root = Root();
+  storage.release();
+  return root;
+}
+
+template <typename T> T* JsonArena::Allocate(size_t count) {
+  static_assert(alignof(T) <= alignof(std::max_align_t));
+  // every block starts max aligned, keep each run aligned for both node types
+  constexpr size_t alignment = std::max(alignof(Tracks::ffi::FFIJsonValue), alignof(Tracks::ffi::JsonArray));
+  size_t size = (count * sizeof(T) + alignment - 1) & ~(alignment - 1);
+
+  for (; block < blocks.size(); block++, offset = 0) {
+    auto& current = blocks[block];
+    if (offset + size <= current.size) {
+      auto* run = reinterpret_cast<T*>(current.data.get() + offset);
+      offset += size;
+      return run;
+    }
+  }
+
+  auto blockSize = std::max(blockBytes, size);
+  auto& added = blocks.emplace_back(Block{ std::make_unique<std::byte[]>(blockSize), blockSize });
+  offset = size;
+  return reinterpret_cast<T*>(added.data.get());
+}
+
+Tracks::ffi::FFIJsonValue const* JsonArena::Convert(rapidjson::Value const& value) {
+  struct ArenaBump {
+    JsonArena& arena;
+
+    Tracks::ffi::FFIJsonValue* Values(size_t count) {
+      return arena.Allocate<Tracks::ffi::FFIJsonValue>(count);
+    }
+    Tracks::ffi::JsonArray* Array() {
+      return arena.Allocate<Tracks::ffi::JsonArray>(1);
+    }
+  } bump{ *this };
+
+  auto pending = releaseRequests.load(std::memory_order_relaxed);
+  if (releases != pending) {
+    releases = pending;
+    Release();
+  }
+  Reset();
+  auto* root = bump.Values(1);
+  fillJson(*root, value, bump);
+  return root;
+}
+
+void JsonArena::Reset() {
+  block = 0;
+  offset = 0;
+}
+
+void JsonArena::Release() {
+  blocks.clear();
+  blocks.shrink_to_fit();
+  Reset();
+}
+
+size_t JsonArena::Capacity() const {
+  size_t capacity = 0;
+  for (auto const& current : blocks) {
+    capacity += current.size;
+  }
+  return capacity;
+}
+
+JsonArena& JsonArena::ForThread() {
+  static thread_local JsonArena arena;
+  return arena;
+}
+
+void JsonArena::ReleaseAll() {
+  // other threads may be converting right now, they free their own blocks once they are done
+  auto& arena = ForThread();
+  arena.releases = releaseRequests.fetch_add(1, std::memory_order_relaxed) + 1;
+  arena.Release();
+}
+
 const Tracks::ffi::FFIJsonValue* convert_rapidjson(rapidjson::Value const& value) {
-    // Handle different types of rapidjson values
-    if (value.IsNumber()) {
-        return new Tracks::ffi::FFIJsonValue{Tracks::ffi::JsonValueType::Number, {.number_value = value.GetDouble()}};
-    } else if (value.IsNull()) {
-        return new Tracks::ffi::FFIJsonValue{Tracks::ffi::JsonValueType::Null, {}};
-    } else if (value.IsString()) {
-        return new Tracks::ffi::FFIJsonValue{Tracks::ffi::JsonValueType::String, {.string_value = value.GetString()}};
-    } else if (value.IsArray()) {
-        // Create array of FFIJsonValue for each element in the array
-        auto size = value.Size();
-        auto *elements = new Tracks::ffi::FFIJsonValue[size];
-        
-        for (size_t i = 0; i < size; i++) {
-            elements[i] = *convert_rapidjson(value[i]);
-        }
-        
-        auto jsonArray = new Tracks::ffi::JsonArray{elements, size};
-        return new Tracks::ffi::FFIJsonValue{Tracks::ffi::JsonValueType::Array, {.array = jsonArray}};
-    } else {
-        TLogger::Logger.error("Unsupported JSON value type in conversion");
-        // Return null as fallback
-        return new Tracks::ffi::FFIJsonValue{Tracks::ffi::JsonValueType::Null, {}};
+  ConvertedJson converted(value);
+  countConverted(converted.Nodes(), converted.Bytes());
+  return converted.Release();
+}
+
+namespace {
+uint32_t componentCount(Tracks::ffi::WrapBaseValueType type) {
+  switch (type) {
+  case Tracks::ffi::WrapBaseValueType::Float:
+    return 1;
+  case Tracks::ffi::WrapBaseValueType::Vec3:
+    return 3;
+  case Tracks::ffi::WrapBaseValueType::Quat:
+  case Tracks::ffi::WrapBaseValueType::Vec4:
+    return 4;
+  default:
+    return 0;
+  }
+}
+
+void copyComponents(Tracks::ffi::WrapBaseValue const& value, float* out) {
+  switch (value.ty) {
+  case Tracks::ffi::WrapBaseValueType::Float:
+    out[0] = value.value.float_v;
+    break;
+  case Tracks::ffi::WrapBaseValueType::Vec3:
+    out[0] = value.value.vec3.x;
+    out[1] = value.value.vec3.y;
+    out[2] = value.value.vec3.z;
+    break;
+  case Tracks::ffi::WrapBaseValueType::Quat:
+    out[0] = value.value.quat.x;
+    out[1] = value.value.quat.y;
+    out[2] = value.value.quat.z;
+    out[3] = value.value.quat.w;
+    break;
+  case Tracks::ffi::WrapBaseValueType::Vec4:
+    out[0] = value.value.vec4.x;
+    out[1] = value.value.vec4.y;
+    out[2] = value.value.vec4.z;
+    out[3] = value.value.vec4.w;
+    break;
+  default:
+    break;
+  }
+}
+
+// largest difference between value and the lerp of a and b at fraction, the same nlerp InterpolateQuaternion does
+// for quaternions
+float lerpError(Tracks::ffi::WrapBaseValueType type, uint32_t components, float const* a, float const* b,
+                float fraction, float const* value) {
+  float lerped[4];
+  float length = 0;
+  for (uint32_t c = 0; c < components; c++) {
+    lerped[c] = a[c] + (b[c] - a[c]) * fraction;
+    length += lerped[c] * lerped[c];
+  }
+  if (type == Tracks::ffi::WrapBaseValueType::Quat && length > 0) {
+    length = std::sqrt(length);
+    for (uint32_t c = 0; c < components; c++) lerped[c] /= length;
+  }
+  float error = 0;
+  for (uint32_t c = 0; c < components; c++) {
+    float diff = std::abs(value[c] - lerped[c]);
+    error = std::isnan(diff) ? INFINITY : std::max(error, diff);
+  }
+  return error;
+}
+
+// narrowest adaptive segment, jumps such as step easings are kept to a window this wide
+constexpr float minAdaptiveWidth = 1.0f / float(1 << 22);
+} // namespace
+
+std::optional<BakedPointDefinition> BakedPointDefinition::Bake(PointDefinitionW const& definition,
+                                                               Options options) {
+  if (!definition || definition.hasBaseProvider()) return std::nullopt;
+
+  auto type = definition.GetType();
+  auto components = componentCount(type);
+  if (components == 0 || options.resolution == 0) return std::nullopt;
+
+  auto sample = [&](float time, float* out) {
+    bool last;
+    copyComponents(definition.Interpolate(time, last), out);
+    return last;
+  };
+
+  // two cells per point at least, so fewer cells hold several points whose effects could cancel out
+  uint32_t resolution = options.resolution;
+  while (resolution < 2 * definition.count() && resolution * 2 <= options.maxResolution) {
+    resolution *= 2;
+  }
+  std::vector<float> grid((resolution + 1) * components);
+  for (uint32_t i = 0; i <= resolution; i++) {
+    sample(float(i) / float(resolution), &grid[i * components]);
+  }
+  std::vector<float> midpoints(resolution * components);
+  for (uint32_t i = 0; i < resolution; i++) {
+    sample((float(i) + 0.5f) / float(resolution), &midpoints[i * components]);
+  }
+
+  // each cell is checked at its middle and quarters, the quarters of one resolution are the midpoints of the next and
+  // the midpoints its new rows, so nothing is sampled twice
+  std::vector<float> quarters;
+  std::vector<float> refined;
+  float error;
+  bool adaptive = false;
+  while (true) {
+    quarters.resize(2 * resolution * components);
+    error = 0;
+    for (uint32_t i = 0; i < resolution; i++) {
+      auto* quarter = &quarters[2 * i * components];
+      sample((float(i) + 0.25f) / float(resolution), quarter);
+      sample((float(i) + 0.75f) / float(resolution), quarter + components);
+      auto const* row = &grid[i * components];
+      auto const* next = row + components;
+      error = std::max(error, lerpError(type, components, row, next, 0.5f, &midpoints[i * components]));
+      error = std::max(error, lerpError(type, components, row, next, 0.25f, quarter));
+      error = std::max(error, lerpError(type, components, row, next, 0.75f, quarter + components));
+    }
+
+    if (error <= options.tolerance) break;
+    if (resolution * 2 > options.maxResolution) {
+      adaptive = true;
+      break;
+    }
+
+    refined.resize((resolution * 2 + 1) * components);
+    for (uint32_t i = 0; i < resolution; i++) {
+      std::copy_n(&grid[i * components], components, &refined[2 * i * components]);
+      std::copy_n(&midpoints[i * components], components, &refined[(2 * i + 1) * components]);
+    }
+    std::copy_n(&grid[resolution * components], components, &refined[2 * resolution * components]);
+    grid.swap(refined);
+    midpoints.swap(quarters);
+    resolution *= 2;
+  }
+
+  BakedPointDefinition baked;
+  baked.type = type;
+  baked.components = components;
+
+  if (!adaptive) {
+    baked.samples = std::move(grid);
+    baked.resolution = resolution;
+    baked.measuredError = error;
+  } else {
+    // only the segments of the last uniform grid over the tolerance are split
+    std::vector<float> rows(grid.begin(), grid.begin() + components);
+    std::vector<float> times{ 0 };
+    error = 0;
+
+    struct Pending {
+      float time;
+      float value[4];
+    };
+    // right ends of the segments left to check, the next one to append is at the back
+    std::vector<Pending> pending;
+    for (uint32_t i = resolution; i > 0; i--) {
+      auto& end = pending.emplace_back();
+      end.time = float(i) / float(resolution);
+      std::copy_n(&grid[i * components], components, end.value);
     }
+
+    while (!pending.empty()) {
+      if (times.size() > options.maxSamples) return std::nullopt;
+
+      float start = times.back();
+      auto const* startValue = &rows[rows.size() - components];
+      auto end = pending.back();
+      float width = end.time - start;
+
+      // the quarters too, several points in one segment can cancel out at the midpoint
+      Pending mid;
+      mid.time = start + width * 0.5f;
+      sample(mid.time, mid.value);
+      float segmentError = lerpError(type, components, startValue, end.value, 0.5f, mid.value);
+      for (float fraction : { 0.25f, 0.75f }) {
+        float quarter[4];
+        sample(start + width * fraction, quarter);
+        segmentError = std::max(segmentError, lerpError(type, components, startValue, end.value, fraction, quarter));
+      }
+      if (segmentError > options.tolerance && width > minAdaptiveWidth) {
+        pending.push_back(mid);
+        continue;
+      }
+
+      // a jump narrowed to the minimum width is kept and counted like any other segment, a NaN is never baked
+      if (std::isinf(segmentError)) return std::nullopt;
+      error = std::max(error, segmentError);
+      times.push_back(end.time);
+      rows.insert(rows.end(), end.value, end.value + components);
+      pending.pop_back();
+    }
+
+    baked.resolution = static_cast<uint32_t>(times.size() - 1);
+    baked.samples = std::move(rows);
+    baked.times = std::move(times);
+    baked.measuredError = error;
+  }
+
+  // last only flips once, from false to true at the time of the last point
+  float scratch[4];
+  if (!sample(1, scratch)) {
+    baked.lastTime = INFINITY;
+  } else if (sample(0, scratch)) {
+    baked.lastTime = 0;
+  } else {
+    float low = 0;
+    float high = 1;
+    for (int i = 0; i < 24; i++) {
+      float middle = (low + high) * 0.5f;
+      (sample(middle, scratch) ? high : low) = middle;
+    }
+    baked.lastTime = high;
+  }
+  return baked;
+}
+
+// FNV-1a over the bytes of one canonical value
+static void hashBytes(uint64_t& hash, void const* data, size_t size) {
+  for (auto byte : std::span(static_cast<uint8_t const*>(data), size)) {
+    hash = (hash ^ byte) * 0x100000001b3ULL;
+  }
+}
+
+static void hashCanonical(uint64_t& hash, rapidjson::Value const& value) {
+  // mirrors convert_rapidjson, anything it does not support becomes null there and here
+  if (value.IsNumber()) {
+    double number = value.GetDouble();
+    hashBytes(hash, "n", 1);
+    hashBytes(hash, &number, sizeof(number));
+  } else if (value.IsString()) {
+    uint32_t length = value.GetStringLength();
+    hashBytes(hash, "s", 1);
+    hashBytes(hash, &length, sizeof(length));
+    hashBytes(hash, value.GetString(), length);
+  } else if (value.IsArray()) {
+    uint32_t size = value.Size();
+    hashBytes(hash, "a", 1);
+    hashBytes(hash, &size, sizeof(size));
+    for (auto const& element : value.GetArray()) {
+      hashCanonical(hash, element);
+    }
+  } else {
+    hashBytes(hash, "z", 1);
+  }
+}
+
+uint64_t CanonicalPointDataHash(rapidjson::Value const& value) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  hashCanonical(hash, value);
+  return hash;
 }
 
 void PointDefinitionManager::AddPoint(std::string const& pointDataName, const rapidjson::Value& pointData) {
@@ -0,0 +1,142 @@
+#include "Animation/PointDefinitionBatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "beatsaber-hook/shared/utils/typedefs.h"
+
+using namespace Tracks;
+
+namespace {
+// indices of samples by definition then time, NaN times last. Sorted input, the usual case, is not sorted again
+std::span<uint32_t const> GroupedOrder(std::span<PointSample const> samples) {
+  struct Key {
+    PointSample sample;
+    uint32_t index;
+  };
+  static thread_local std::vector<Key> keys;
+  static thread_local std::vector<uint32_t> order;
+
+  auto before = [](PointSample const& a, PointSample const& b) {
+    if (a.definition != b.definition) return std::less<>()(a.definition, b.definition);
+    return a.time < b.time || (!std::isnan(a.time) && std::isnan(b.time));
+  };
+  order.resize(samples.size());
+  if (std::is_sorted(samples.begin(), samples.end(), before)) {
+    std::iota(order.begin(), order.end(), 0);
+    return order;
+  }
+
+  // sorted by value, comparing through the indices would miss the cache on every step
+  keys.resize(samples.size());
+  for (uint32_t i = 0; i < samples.size(); i++) {
+    keys[i] = { samples[i], i };
+  }
+  std::sort(keys.begin(), keys.end(), [&](Key const& a, Key const& b) { return before(a.sample, b.sample); });
+  std::transform(keys.begin(), keys.end(), order.begin(), [](Key const& key) { return key.index; });
+  return order;
+}
+
+// interpolate(definition, baked, time, last, segment) evaluates one sample, store(i, value) writes one result into
+// the outputs
+template <typename Interpolate, typename Store>
+void InterpolateBatch(std::span<PointSample const> samples, std::span<bool> last, Interpolate&& interpolate,
+                      Store&& store) {
+  CRASH_UNLESS(last.empty() || last.size() >= samples.size());
+
+  PointSample previous{ nullptr, 0 };
+  BakedPointDefinition const* baked = nullptr;
+  // walks each baked table forward, times only go up within a definition
+  uint32_t segment = 0;
+  std::invoke_result_t<Interpolate&, PointDefinitionW const&, BakedPointDefinition const*, float, bool&, uint32_t&>
+      value{};
+  bool valueLast = false;
+  for (auto i : GroupedOrder(samples)) {
+    auto const& sample = samples[i];
+    if (sample.definition != previous.definition) {
+      baked = sample.definition->GetBaked();
+      segment = 0;
+    }
+    // NaN never equals itself, so it is always evaluated
+    if (sample.definition != previous.definition || sample.time != previous.time) {
+      value = interpolate(*sample.definition, baked, sample.time, valueLast, segment);
+    }
+    previous = sample;
+    store(i, value);
+    if (!last.empty()) last[i] = valueLast;
+  }
+}
+} // namespace
+
+void Tracks::InterpolateVec3Batch(std::span<PointSample const> samples, std::span<float> xs, std::span<float> ys,
+                                  std::span<float> zs, std::span<bool> last) {
+  CRASH_UNLESS(xs.size() >= samples.size() && ys.size() >= samples.size() && zs.size() >= samples.size());
+  InterpolateBatch(
+      samples, last,
+      [](PointDefinitionW const& definition, BakedPointDefinition const* baked, float time, bool& isLast,
+         uint32_t& segment) {
+        if (baked && baked->Covers(time)) return baked->InterpolateVec3(time, isLast, segment);
+        return definition.InterpolateVec3(time, isLast);
+      },
+      [&](size_t i, NEVector::Vector3 const& value) {
+        xs[i] = value.x;
+        ys[i] = value.y;
+        zs[i] = value.z;
+      });
+}
+
+void Tracks::InterpolateQuaternionBatch(std::span<PointSample const> samples, std::span<float> xs,
+                                        std::span<float> ys, std::span<float> zs, std::span<float> ws,
+                                        std::span<bool> last) {
+  CRASH_UNLESS(xs.size() >= samples.size() && ys.size() >= samples.size() && zs.size() >= samples.size() &&
+               ws.size() >= samples.size());
+  InterpolateBatch(
+      samples, last,
+      [](PointDefinitionW const& definition, BakedPointDefinition const* baked, float time, bool& isLast,
+         uint32_t& segment) {
+        if (baked && baked->Covers(time)) return baked->InterpolateQuaternion(time, isLast, segment);
+        return definition.InterpolateQuaternion(time, isLast);
+      },
+      [&](size_t i, NEVector::Quaternion const& value) {
+        xs[i] = value.x;
+        ys[i] = value.y;
+        zs[i] = value.z;
+        ws[i] = value.w;
+      });
+}
+
+void Tracks::InterpolateVector4Batch(std::span<PointSample const> samples, std::span<float> xs, std::span<float> ys,
+                                     std::span<float> zs, std::span<float> ws, std::span<bool> last) {
+  CRASH_UNLESS(xs.size() >= samples.size() && ys.size() >= samples.size() && zs.size() >= samples.size() &&
+               ws.size() >= samples.size());
+  InterpolateBatch(
+      samples, last,
+      [](PointDefinitionW const& definition, BakedPointDefinition const* baked, float time, bool& isLast,
+         uint32_t& segment) {
+        if (baked && baked->Covers(time)) return baked->InterpolateVector4(time, isLast, segment);
+        return definition.InterpolateVector4(time, isLast);
+      },
+      [&](size_t i, NEVector::Vector4 const& value) {
+        xs[i] = value.x;
+        ys[i] = value.y;
+        zs[i] = value.z;
+        ws[i] = value.w;
+      });
+}
+
+void Tracks::InterpolateLinearBatch(std::span<PointSample const> samples, std::span<float> values,
+                                    std::span<bool> last) {
+  CRASH_UNLESS(values.size() >= samples.size());
+  InterpolateBatch(
+      samples, last,
+      [](PointDefinitionW const& definition, BakedPointDefinition const* baked, float time, bool& isLast,
+         uint32_t& segment) {
+        if (baked && baked->Covers(time)) return baked->InterpolateLinear(time, isLast, segment);
+        return definition.InterpolateLinear(time, isLast);
+      },
+      [&](size_t i, float value) { values[i] = value; });
+}
@@ -0,0 +1,28 @@
+#include "Animation/Track.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Hash.h"
+
+// keys are never erased, the node based map keeps the interned strings where they are
+static std::unordered_map<std::string, PropertyHandle, TracksAD::string_hash, TracksAD::string_equal> internedProperties;
+static std::mutex internedPropertiesMutex;
+
+PropertyHandle PropertyHandle::Resolve(std::string_view name) {
+  std::lock_guard lock(internedPropertiesMutex);
+
+  auto it = internedProperties.find(name);
+  if (it != internedProperties.end()) {
+    return it->second;
+  }
+
+  it = internedProperties.emplace(std::string(name), PropertyHandle()).first;
+  auto& handle = it->second;
+  handle.name = TRACKS_FFI(string_to_property_name)(it->first.c_str());
+  if (!handle.IsNamed()) {
+    handle.custom = it->first.c_str();
+  }
+  return handle;
+}
@@ -5,6 +5,7 @@
 #include "bindings.h"
 #include "custom-json-data/shared/CustomBeatmapData.h"
 #include "TLogger.h"
+#include "Profiling.h"
 #include "sv/small_vector.h"
 
 using namespace TracksAD;
@@ -39,17 +40,74 @@ inline bool IsStringProperties(std::string_view n) {
          n != REPEAT;
 }
 
-PropertyId toPropertyId(std::string_view name) {
-  using namespace Tracks::ffi;
-  auto propName = Tracks::ffi::string_to_property_name(name.data());
+namespace {
+// rough sizes of the Rust side objects, per point of a point definition and per track with its properties
+constexpr size_t rustPointBytesEstimate = 48;
+constexpr size_t rustTrackBytesEstimate = 1024;
 
-  if (propName != PropertyNames::UnknownPropertyName) {
-    return propName;
+// libc++ unordered_map node: next pointer and cached hash in front of the value, plus one bucket pointer
+template <typename Map> constexpr size_t mapNodeBytes() {
+  return sizeof(typename Map::value_type) + 2 * sizeof(void*) + sizeof(void*);
+}
+
+size_t stringHeapBytes(std::string const& str) {
+  // short strings live inline
+  return str.capacity() > sizeof(std::string) - 2 ? str.capacity() + 1 : 0;
+}
+
+size_t pointDefinitionBytes(PointDefinitionW const& pointDefinition) {
+  if (!pointDefinition) return 0;
+  return pointDefinition.count() * rustPointBytesEstimate;
+}
+} // namespace
+
+BeatmapMemoryStats BeatmapAssociatedData::GetMemoryStats() const {
+  BeatmapMemoryStats stats;
+
+  stats.pointDefinitions.count = pointDefinitions.size();
+  for (auto const& [key, pointDefinition] : pointDefinitions) {
+    stats.pointDefinitions.bytes += mapNodeBytes<decltype(pointDefinitions)>() + stringHeapBytes(key.first) +
+                                    pointDefinitionBytes(pointDefinition);
+  }
+
+  stats.pointDefinitionAnonymous.count = pointDefinitionAnonymous.size() + pointDefinitionAnonymousLookup.size();
+  stats.pointDefinitionAnonymous.bytes = pointDefinitionAnonymous.capacity() * sizeof(PointDefinitionW);
+  for (auto const& pointDefinition : pointDefinitionAnonymous) {
+    stats.pointDefinitionAnonymous.bytes += pointDefinitionBytes(pointDefinition);
+  }
+  for (auto const& [hash, inlineDefinition] : pointDefinitionAnonymousLookup) {
+    stats.pointDefinitionAnonymous.bytes += mapNodeBytes<decltype(pointDefinitionAnonymousLookup)>() +
+                                            pointDefinitionBytes(inlineDefinition.pointDefinition);
+  }
+
+  stats.pointDefinitionsJSON.count = pointDefinitionsJSON.size();
+  for (auto const& [name, json] : pointDefinitionsJSON) {
+    stats.pointDefinitionsJSON.bytes += mapNodeBytes<decltype(pointDefinitionsJSON)>() + stringHeapBytes(name);
   }
-  return std::string(name);
+
+  stats.tracks.count = TRACKS_FFI(tracks_holder_count)(*tracks_holder);
+  stats.tracks.bytes = stats.tracks.count * rustTrackBytesEstimate;
+
+  stats.eventData.count = eventDataMap.size();
+  for (auto const& [customEventData, eventAD] : eventDataMap) {
+    stats.eventData.bytes += mapNodeBytes<decltype(eventDataMap)>();
+    if (eventAD.rustEventData.size() > 1) {
+      stats.eventData.bytes += eventAD.rustEventData.capacity() * sizeof(std::shared_ptr<EventDataW>);
+    }
+
+    stats.rustEventData.count += eventAD.rustEventData.size();
+    // make_shared control block with the wrapper, plus the Rust copy of the event
+    stats.rustEventData.bytes += eventAD.rustEventData.size() * (2 * sizeof(void*) + sizeof(EventDataW) +
+                                                                 sizeof(Tracks::ffi::CEventData));
+  }
+
+  auto converted = GetConvertRapidjsonStats();
+  stats.convertedJson = { converted.nodes, converted.bytes };
+
+  return stats;
 }
 
-constexpr static float getFloat(rapidjson::Value const& value) {
+static float getFloat(rapidjson::Value const& value) {
   switch (value.GetType()) {
   case rapidjson::kStringType:
     return std::stof(value.GetString());
@@ -69,7 +127,8 @@ makePathEvent(float eventTime, CustomEventAssociatedData const& eventAD, Beatmap
   for (auto const& member : customData.GetObject()) {
     char const* name = member.name.GetString();
     if (IsStringProperties(name)) {
-      auto property = track.GetPathProperty(name);
+      auto propertyHandle = PropertyHandle::Resolve(name);
+      auto property = track.GetPathProperty(propertyHandle);
       if (!property) {
         TLogger::Logger.warn("Could not find track path property with name {}", name);
         continue;
@@ -78,21 +137,10 @@ makePathEvent(float eventTime, CustomEventAssociatedData const& eventAD, Beatmap
 
       auto pointData = Animation::ParsePointData(beatmapAD, customData, name, type);
 
-      auto propertyId = toPropertyId(name);
-      auto propertyHandle = std::holds_alternative<std::string>(propertyId)
-                                                  ? Tracks::ffi::CEventPropertyId{
-                                                        .property_str = std::get<std::string>(propertyId).c_str(),
-                                                    }
-                                                  : Tracks::ffi::CEventPropertyId{
-                                                        .property_name = std::get<Tracks::ffi::PropertyNames>(propertyId),
-                                                    };
-
       auto eventType = Tracks::ffi::CEventType{
         .ty = Tracks::ffi::CEventTypeEnum::AssignPathAnimation,
-        .property_id = propertyHandle,
-        .property_id_type = std::holds_alternative<std::string>(propertyId)
-                                ? Tracks::ffi::CEventPropertyIdType::CString
-                                : Tracks::ffi::CEventPropertyIdType::PropertyName,
+        .property_id = propertyHandle.EventPropertyId(),
+        .property_id_type = propertyHandle.EventPropertyIdType(),
       };
 
       Tracks::ffi::CEventData cEventData = {
@@ -104,7 +152,7 @@ makePathEvent(float eventTime, CustomEventAssociatedData const& eventAD, Beatmap
         .track_key = track.track,
         .point_data_ptr = pointData,
       };
-      auto eventData = Tracks::ffi::event_data_to_rust(&cEventData);
+      auto eventData = TRACKS_FFI(event_data_to_rust)(&cEventData);
       CRASH_UNLESS(eventData);
       events.emplace_back(std::make_shared<EventDataW>(eventData));
     }
@@ -122,7 +170,8 @@ makeAnimateEvent(float eventTime, CustomEventAssociatedData const& eventAD, Beat
     if (!IsStringProperties(name)) {
       continue;
     }
-    auto property = track.GetProperty(name);
+    auto propertyHandle = PropertyHandle::Resolve(name);
+    auto property = track.GetProperty(propertyHandle);
     if (!property) {
       TLogger::Logger.warn("Could not find track property with name {}", name);
 
@@ -132,22 +181,10 @@ makeAnimateEvent(float eventTime, CustomEventAssociatedData const& eventAD, Beat
 
     auto pointData = Animation::ParsePointData(beatmapAD, customData, name, type);
 
-    auto propertyId = toPropertyId(name);
-
-    auto propertyHandle = std::holds_alternative<std::string>(propertyId)
-                                                  ? Tracks::ffi::CEventPropertyId{
-                                                        .property_str = std::get<std::string>(propertyId).c_str(),
-                                                    }
-                                                  : Tracks::ffi::CEventPropertyId{
-                                                        .property_name = std::get<Tracks::ffi::PropertyNames>(propertyId),
-                                                    };
-
     auto eventType = Tracks::ffi::CEventType{
       .ty = Tracks::ffi::CEventTypeEnum::AnimateTrack,
-      .property_id = propertyHandle,
-      .property_id_type = std::holds_alternative<std::string>(propertyId)
-                              ? Tracks::ffi::CEventPropertyIdType::CString
-                              : Tracks::ffi::CEventPropertyIdType::PropertyName,
+      .property_id = propertyHandle.EventPropertyId(),
+      .property_id_type = propertyHandle.EventPropertyIdType(),
     };
 
     Tracks::ffi::CEventData cEventData = {
@@ -160,7 +197,7 @@ makeAnimateEvent(float eventTime, CustomEventAssociatedData const& eventAD, Beat
       .point_data_ptr = pointData,
     };
 
-    auto eventData = Tracks::ffi::event_data_to_rust(&cEventData);
+    auto eventData = TRACKS_FFI(event_data_to_rust)(&cEventData);
     CRASH_UNLESS(eventData);
     events.emplace_back(std::make_shared<EventDataW>(eventData));
   }
@@ -170,6 +207,7 @@ makeAnimateEvent(float eventTime, CustomEventAssociatedData const& eventAD, Beat
 
 void LoadTrackEvent(CustomJSONData::CustomEventData* customEventData, TracksAD::BeatmapAssociatedData& beatmapAD,
                     bool v2) {
+  TRACKS_PROFILE_ZONE("LoadTrackEvent");
   auto typeHash = customEventData->typeHash;
 
 #define TYPE_GET(jsonName, varName) static auto jsonNameHash_##varName = std::hash<std::string_view>()(jsonName);
@@ -249,6 +287,7 @@ void LoadTrackEvent(CustomJSONData::CustomEventData* customEventData, TracksAD::
 }
 
 void readBeatmapDataAD(CustomJSONData::CustomBeatmapData* beatmapData) {
+  TRACKS_PROFILE_ZONE("readBeatmapDataAD");
   static auto* customObstacleDataClass = classof(CustomJSONData::CustomObstacleData*);
   static auto* customNoteDataClass = classof(CustomJSONData::CustomNoteData*);
   static auto* customSliderDataClass = classof(CustomJSONData::CustomSliderData*);
@@ -347,6 +386,16 @@ void readBeatmapDataAD(CustomJSONData::CustomBeatmapData* beatmapData) {
     LoadTrackEvent(customEventData, beatmapAD, beatmapData->v2orEarlier);
   }
 
+#ifdef TRACKS_MEMORY_ACCOUNTING
+  auto memoryStats = beatmapAD.GetMemoryStats();
+  TLogger::Logger.info("Beatmap AD: {} tracks, {} point definitions, {} anonymous, ~{} KiB est. Shared: {} events, "
+                       "~{} KiB est. (converted JSON so far ~{} KiB)",
+                       memoryStats.tracks.count, memoryStats.pointDefinitions.count,
+                       memoryStats.pointDefinitionAnonymous.count, memoryStats.TotalBytes() / 1024,
+                       memoryStats.rustEventData.count, memoryStats.SharedBytes() / 1024,
+                       memoryStats.convertedJson.bytes / 1024);
+#endif
+
   beatmapAD.valid = true;
 }
 
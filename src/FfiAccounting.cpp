@@ -0,0 +1,80 @@
+#include "FfiAccounting.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+#include "TLogger.h"
+
+namespace Tracks::FfiAccounting {
+
+namespace {
+
+// deque keeps the stats where they are when more symbols register
+std::mutex symbolsMutex;
+std::deque<SymbolStats> symbols;
+
+std::atomic<uint64_t> frames = 0;
+
+} // namespace
+
+SymbolStats& Register(char const* name) {
+  std::lock_guard lock(symbolsMutex);
+  auto& stats = symbols.emplace_back();
+  stats.name = name;
+  return stats;
+}
+
+std::vector<SymbolReport> Snapshot() {
+  std::vector<SymbolReport> reports;
+  {
+    std::lock_guard lock(symbolsMutex);
+    reports.reserve(symbols.size());
+    for (auto const& stats : symbols) {
+      reports.push_back(
+          { stats.name, stats.calls.load(std::memory_order_relaxed), stats.ns.load(std::memory_order_relaxed) });
+    }
+  }
+
+  std::sort(reports.begin(), reports.end(), [](auto const& a, auto const& b) { return a.ns > b.ns; });
+  return reports;
+}
+
+uint64_t FrameCount() {
+  return frames.load(std::memory_order_relaxed);
+}
+
+void Reset() {
+  std::lock_guard lock(symbolsMutex);
+  for (auto& stats : symbols) {
+    stats.calls.store(0, std::memory_order_relaxed);
+    stats.ns.store(0, std::memory_order_relaxed);
+  }
+  frames.store(0, std::memory_order_relaxed);
+}
+
+void EndFrame() {
+  auto frameCount = frames.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (frameCount < reportInterval) return;
+
+  auto reports = Snapshot();
+  uint64_t totalCalls = 0;
+  uint64_t totalNs = 0;
+  for (auto const& report : reports) {
+    totalCalls += report.calls;
+    totalNs += report.ns;
+  }
+
+  TLogger::Logger.info("FFI over {} frames: {:.1f} calls/frame, {:.1f} us/frame", frameCount,
+                       double(totalCalls) / double(frameCount), double(totalNs) / double(frameCount) / 1000.0);
+  for (auto const& report : reports) {
+    if (report.calls == 0) continue;
+    TLogger::Logger.info("  {}: {:.1f} calls/frame, {:.1f} ns/call, {:.1f} us/frame", report.name,
+                         double(report.calls) / double(frameCount), double(report.ns) / double(report.calls),
+                         double(report.ns) / double(frameCount) / 1000.0);
+  }
+
+  Reset();
+}
+
+} // namespace Tracks::FfiAccounting
@@ -14,6 +14,7 @@
 
 #include "Animation/PointDefinition.h"
 #include "bindings.h"
+#include "Profiling.h"
 
 using namespace CustomJSONData;
 using namespace GlobalNamespace;
@@ -79,6 +80,7 @@ MAKE_HOOK_MATCH(GameplayCoreInstaller_InstallBindings, &GlobalNamespace::Gamepla
 MAKE_HOOK_MATCH(PlayerTransforms_Update, &GlobalNamespace::PlayerTransforms::Update, void,
                 GlobalNamespace::PlayerTransforms* self) {
   PlayerTransforms_Update(self);
+  TRACKS_PROFILE_ZONE("PlayerTransforms_Update");
 
   if (!tempCustomBeatmap) {
     return;
@@ -11,6 +11,14 @@
 #include "StaticHolders.hpp"
 
 #include "Animation/GameObjectTrackController.hpp"
+#include "Animation/GameObjectTrackSystem.hpp"
+
+#ifdef TRACKS_SESSION_RECORDING
+#include "SessionRecording.h"
+
+static constexpr std::string_view sessionRecordingDirectory =
+    "/sdcard/ModData/com.beatgames.beatsaber/Mods/Tracks/Sessions";
+#endif
 
 using namespace GlobalNamespace;
 
@@ -31,6 +39,8 @@ custom_types::Helpers::Coroutine updateCoroutines(BeatmapCallbacksController* se
 #pragma clang diagnostic pop
 
 BeatmapCallbacksController* controller;
+// the coroutine only runs for custom beatmaps, the others tick the track controllers from ManualUpdate
+static bool coroutineUpdatesControllers = false;
 SafePtr<BpmController> TracksStatic::bpmController;
 
 MAKE_HOOK_MATCH(BeatmapObjectCallbackController_Start, &BeatmapCallbacksController::ManualUpdate, void,
@@ -38,6 +48,7 @@ MAKE_HOOK_MATCH(BeatmapObjectCallbackController_Start, &BeatmapCallbacksControll
   BeatmapObjectCallbackController_Start(self, songTime);
   if (controller != self) {
     controller = self;
+    coroutineUpdatesControllers = false;
 
     if (auto customBeatmap = il2cpp_utils::try_cast<CustomJSONData::CustomBeatmapData>(self->_beatmapData)) {
       if (customBeatmap.value()->customData) {
@@ -45,12 +56,21 @@ MAKE_HOOK_MATCH(BeatmapObjectCallbackController_Start, &BeatmapCallbacksControll
         Tracks::GameObjectTrackController::LeftHanded = tracksBeatmapAD.leftHanded;
       }
 
+#ifdef TRACKS_SESSION_RECORDING
+      Tracks::SessionRecording::Begin(customBeatmap.value(), sessionRecordingDirectory);
+#endif
+
       UnityEngine::Resources::FindObjectsOfTypeAll<BeatmapCallbacksUpdater*>().get(0)->StartCoroutine(
           custom_types::Helpers::CoroutineHelper::New(updateCoroutines(self)));
+      coroutineUpdatesControllers = true;
     }
 
 
   }
+
+  if (!coroutineUpdatesControllers) {
+    Tracks::GameObjectTrackSystem::UpdateAll();
+  }
 }
 
 MAKE_HOOK_FIND_INSTANCE(BpmController_ctor, classof(BpmController*), ".ctor", void, BpmController* self,
@@ -2,6 +2,8 @@
 #include "beatsaber-hook/shared/utils/hooking.hpp"
 
 #include "Animation/GameObjectTrackController.hpp"
+#include "Animation/GameObjectTrackSystem.hpp"
+#include "Animation/PointDefinition.h"
 
 #include "GlobalNamespace/GameScenesManager.hpp"
 #include "UnityEngine/SceneManagement/SceneManager.hpp"
@@ -10,6 +12,28 @@
 #include "System/Action.hpp"
 #include "custom-json-data/shared/CustomBeatmapData.h"
 
+#ifdef TRACKS_SESSION_RECORDING
+#include "SessionRecording.h"
+#endif
+
+#ifdef TRACKS_PROFILING
+#include <chrono>
+#include <filesystem>
+
+#include "Profiling.h"
+
+static constexpr std::string_view traceDirectory = "/sdcard/ModData/com.beatgames.beatsaber/Mods/Tracks/Traces";
+
+static void DumpTrace() {
+  std::error_code error;
+  std::filesystem::create_directories(traceDirectory, error);
+
+  auto timestamp =
+      std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  Tracks::Profiling::DumpChromeTrace(fmt::format("{}/trace_{}.json", traceDirectory, timestamp));
+}
+#endif
+
 using namespace CustomJSONData;
 using namespace GlobalNamespace;
 using namespace UnityEngine;
@@ -21,6 +45,27 @@ MAKE_HOOK_MATCH(SceneManager_Internal_SceneLoaded, &UnityEngine::SceneManagement
     Tracks::GameObjectTrackController::ClearData();
   }
 
+  // not on GameCore, its controllers are already registered by the time it counts as loaded
+  if (scene.IsValid() && scene.get_name() == "MainMenu") {
+    Tracks::GameObjectTrackSystem::Clear();
+    // sized for the biggest point definition of the last map
+    JsonArena::ReleaseAll();
+  }
+
+#ifdef TRACKS_SESSION_RECORDING
+  // a new map or back to the menu, either way the current session is over
+  if (scene.IsValid() && (scene.get_name() == "GameCore" || scene.get_name() == "MainMenu")) {
+    Tracks::SessionRecording::End();
+  }
+#endif
+
+#ifdef TRACKS_PROFILING
+  // song is over, everything since the last dump goes into one trace
+  if (scene.IsValid() && scene.get_name() == "MainMenu") {
+    DumpTrace();
+  }
+#endif
+
   SceneManager_Internal_SceneLoaded(scene, mode);
 }
 
@@ -0,0 +1,97 @@
+#include "Profiling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "TLogger.h"
+
+namespace Tracks::Profiling {
+
+namespace {
+
+constexpr uint64_t ringCapacity = 1 << 16;
+
+/// Single writer ring, only the owning thread submits. Readers take what was published through `written`.
+struct ThreadBuffer {
+  uint32_t threadIndex;
+  std::unique_ptr<ZoneRecord[]> records = std::make_unique<ZoneRecord[]>(ringCapacity);
+  std::atomic<uint64_t> written = 0;
+  std::atomic<uint64_t> consumed = 0;
+};
+
+// only locked when a thread submits its first zone, or when dumping
+std::mutex buffersMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+ThreadBuffer& LocalBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto created = std::make_shared<ThreadBuffer>();
+    std::lock_guard lock(buffersMutex);
+    created->threadIndex = static_cast<uint32_t>(buffers.size());
+    buffers.push_back(created);
+    return created;
+  }();
+  return *buffer;
+}
+
+} // namespace
+
+void Submit(ZoneRecord const& record) {
+  auto& buffer = LocalBuffer();
+  auto index = buffer.written.load(std::memory_order_relaxed);
+  buffer.records[index % ringCapacity] = record;
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool DumpChromeTrace(std::string_view path) {
+  std::unique_ptr<FILE, decltype(&std::fclose)> file(std::fopen(std::string(path).c_str(), "w"), &std::fclose);
+  if (!file) {
+    TLogger::Logger.error("Could not open trace file {}", path);
+    return false;
+  }
+
+  std::lock_guard lock(buffersMutex);
+
+  // chrome wants microseconds, start at 0 so the numbers stay readable
+  int64_t originNs = INT64_MAX;
+  for (auto const& buffer : buffers) {
+    auto end = buffer->written.load(std::memory_order_acquire);
+    auto begin = std::max(buffer->consumed.load(std::memory_order_relaxed), end > ringCapacity ? end - ringCapacity : 0);
+    for (auto i = begin; i < end; i++) {
+      originNs = std::min(originNs, buffer->records[i % ringCapacity].startNs);
+    }
+  }
+
+  size_t count = 0;
+  std::fputs("{\"traceEvents\":[", file.get());
+  for (auto const& buffer : buffers) {
+    auto end = buffer->written.load(std::memory_order_acquire);
+    auto begin = std::max(buffer->consumed.load(std::memory_order_relaxed), end > ringCapacity ? end - ringCapacity : 0);
+
+    for (auto i = begin; i < end; i++) {
+      auto const& record = buffer->records[i % ringCapacity];
+      fmt::print(file.get(), "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                 count++ == 0 ? "" : ",", record.name, buffer->threadIndex, double(record.startNs - originNs) / 1000.0,
+                 double(record.endNs - record.startNs) / 1000.0);
+    }
+    buffer->consumed.store(end, std::memory_order_relaxed);
+  }
+  std::fputs("]}", file.get());
+
+  TLogger::Logger.info("Wrote {} profiling zones to {}", count, path);
+  return true;
+}
+
+void Clear() {
+  std::lock_guard lock(buffersMutex);
+  for (auto const& buffer : buffers) {
+    buffer->consumed.store(buffer->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+}
+
+} // namespace Tracks::Profiling
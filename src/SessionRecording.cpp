@@ -0,0 +1,186 @@
+#include "SessionRecording.h"
+
+// only the recorder lives here, release builds do not carry it. ReadSession is inline for the host replay
+#ifdef TRACKS_SESSION_RECORDING
+
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/stringbuffer.h"
+#include "beatsaber-hook/shared/rapidjson/include/rapidjson/writer.h"
+#include "custom-json-data/shared/CustomBeatmapData.h"
+#include "custom-json-data/shared/CustomEventData.h"
+
+#include "Constants.h"
+#include "Hash.h"
+#include "TLogger.h"
+
+namespace Tracks::SessionRecording {
+
+namespace {
+
+struct BaseValueSlot {
+  Tracks::ffi::WrapBaseValue value;
+  bool dirty;
+};
+
+struct Recorder {
+  FILE* file = nullptr;
+
+  std::unordered_map<CustomJSONData::CustomEventData const*, uint32_t> eventIndices;
+  std::vector<FiredEvent> pendingFired;
+
+  // index is the base key id written to the file
+  std::unordered_map<std::string, uint16_t, TracksAD::string_hash, TracksAD::string_equal> baseKeyIndices;
+  std::vector<BaseValueSlot> baseValues;
+  std::vector<BaseValueChange> changes;
+
+  template <typename T> void Write(T const& value) {
+    std::fwrite(&value, sizeof(T), 1, file);
+  }
+
+  void WriteString(std::string_view str) {
+    Write(static_cast<uint32_t>(str.size()));
+    std::fwrite(str.data(), 1, str.size(), file);
+  }
+
+  void WriteTag(RecordTag tag) {
+    Write(tag);
+  }
+};
+
+Recorder recorder;
+
+std::string ToJson(rapidjson::Value const& value) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  value.Accept(writer);
+  return { buffer.GetString(), buffer.GetSize() };
+}
+
+} // namespace
+
+void Begin(CustomJSONData::CustomBeatmapData* beatmapData, std::string_view directory) {
+  End();
+
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+
+  auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+  auto path = std::filesystem::path(directory) / fmt::format("session_{}.trks", timestamp);
+
+  recorder.file = std::fopen(path.c_str(), "wb");
+  if (!recorder.file) {
+    TLogger::Logger.error("Could not open session recording {}", path.string());
+    return;
+  }
+  TLogger::Logger.info("Recording session to {}", path.string());
+
+  bool v2 = beatmapData->v2orEarlier;
+  recorder.Write(magic);
+  recorder.Write(version);
+  recorder.Write(static_cast<uint8_t>(v2));
+
+  // only the point definitions are needed to rebuild events
+  std::string beatmapJson = "{}";
+  if (beatmapData->customData && beatmapData->customData->value) {
+    rapidjson::Value const& customData = *beatmapData->customData->value;
+    auto key = v2 ? TracksAD::Constants::V2_POINT_DEFINITIONS : TracksAD::Constants::POINT_DEFINITIONS;
+    auto pointDefinitionsIt = customData.FindMember(key.data());
+    if (pointDefinitionsIt != customData.MemberEnd()) {
+      beatmapJson = fmt::format("{{\"{}\":{}}}", key, ToJson(pointDefinitionsIt->value));
+    }
+  }
+  recorder.WriteTag(RecordTag::Beatmap);
+  recorder.WriteString(beatmapJson);
+
+  // keys and values set before this session started go into the first frame
+  for (auto const& [key, index] : recorder.baseKeyIndices) {
+    recorder.WriteTag(RecordTag::BaseKey);
+    recorder.Write(index);
+    recorder.WriteString(key);
+  }
+  for (auto& slot : recorder.baseValues) {
+    slot.dirty = true;
+  }
+}
+
+void End() {
+  if (!recorder.file) return;
+
+  std::fclose(recorder.file);
+  recorder.file = nullptr;
+  recorder.eventIndices.clear();
+  recorder.pendingFired.clear();
+}
+
+bool IsRecording() {
+  return recorder.file != nullptr;
+}
+
+void RecordEventFired(CustomJSONData::CustomEventData const* customEventData, float bpm, float songTime) {
+  if (!recorder.file) return;
+
+  auto [it, inserted] =
+      recorder.eventIndices.try_emplace(customEventData, static_cast<uint32_t>(recorder.eventIndices.size()));
+  if (inserted) {
+    recorder.WriteTag(RecordTag::Event);
+    recorder.Write(it->second);
+    recorder.WriteString(customEventData->type);
+    recorder.Write(customEventData->time);
+    recorder.WriteString(customEventData->data ? ToJson(*customEventData->data) : "{}");
+  }
+
+  recorder.pendingFired.push_back({ it->second, bpm, songTime });
+}
+
+void RecordBaseValue(std::string_view key, Tracks::ffi::WrapBaseValue const& value) {
+  auto it = recorder.baseKeyIndices.find(key);
+  if (it == recorder.baseKeyIndices.end()) {
+    it = recorder.baseKeyIndices.emplace(key, static_cast<uint16_t>(recorder.baseKeyIndices.size())).first;
+    if (recorder.file) {
+      recorder.WriteTag(RecordTag::BaseKey);
+      recorder.Write(it->second);
+      recorder.WriteString(key);
+    }
+    if (it->second >= recorder.baseValues.size()) {
+      recorder.baseValues.resize(it->second + 1);
+    }
+  }
+
+  auto& slot = recorder.baseValues[it->second];
+  if (!slot.dirty && std::memcmp(&slot.value, &value, sizeof(value)) == 0) return;
+  slot = { value, true };
+}
+
+void RecordFrame(float songTime) {
+  if (!recorder.file) return;
+
+  recorder.changes.clear();
+  for (uint16_t i = 0; i < recorder.baseValues.size(); i++) {
+    auto& slot = recorder.baseValues[i];
+    if (!slot.dirty) continue;
+    slot.dirty = false;
+    recorder.changes.push_back({ i, slot.value });
+  }
+
+  recorder.WriteTag(RecordTag::Frame);
+  recorder.Write(songTime);
+  recorder.Write(static_cast<uint16_t>(recorder.changes.size()));
+  for (auto const& change : recorder.changes) {
+    recorder.Write(change.key);
+    recorder.Write(change.value);
+  }
+  recorder.Write(static_cast<uint16_t>(recorder.pendingFired.size()));
+  for (auto const& fired : recorder.pendingFired) {
+    recorder.Write(fired);
+  }
+  recorder.pendingFired.clear();
+}
+
+} // namespace Tracks::SessionRecording
+
+#endif
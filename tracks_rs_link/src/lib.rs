@@ -1,7 +1,10 @@
 pub extern crate tracks_rs;
 
+#[cfg(target_os = "android")]
 use android_logger::Config;
-use log::{LevelFilter, error, info};
+#[cfg(target_os = "android")]
+use log::LevelFilter;
+use log::{error, info};
 use std::backtrace::Backtrace;
 use std::ffi::CString;
 use std::panic::PanicHookInfo;
@@ -29,6 +32,8 @@ fn main() {
     //     info!("Failed to initialize paper2 tracing, falling back to android_logger");
     // };
     
+    // host builds (benchmarks) have no logcat, the log facade stays a no-op there
+    #[cfg(target_os = "android")]
     android_logger::init_once(Config::default().with_max_level(LevelFilter::Trace));
     info!("tracks_rs_link initialized");
     std::panic::set_hook(panic_hook(true, true));